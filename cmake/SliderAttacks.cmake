@@ -0,0 +1,25 @@
+if (CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64)$")
+  option(PRODIGY_PEXT "Build the PEXT slider attack backend, which needs a CPU with BMI2." ON)
+else()
+  set(PRODIGY_PEXT OFF)
+endif()
+
+if (PRODIGY_PEXT)
+  add_compile_definitions(PRODIGY_PEXT)
+endif()
+
+set(PRODIGY_SLIDER_BACKENDS magic pext hyperbola)
+set(PRODIGY_SLIDER_BACKEND "" CACHE STRING
+    "Slider attack backend that every lookup is compiled against: magic, pext or hyperbola. If empty, pext when the \
+build targets BMI2 and is not tuned for AMD family 17h, otherwise magic.")
+set_property(CACHE PRODIGY_SLIDER_BACKEND PROPERTY STRINGS "" ${PRODIGY_SLIDER_BACKENDS})
+
+if (PRODIGY_SLIDER_BACKEND)
+  if (NOT PRODIGY_SLIDER_BACKEND IN_LIST PRODIGY_SLIDER_BACKENDS)
+    message(FATAL_ERROR "Unknown slider attack backend: ${PRODIGY_SLIDER_BACKEND}")
+  endif()
+  if (PRODIGY_SLIDER_BACKEND STREQUAL "pext" AND NOT PRODIGY_PEXT)
+    message(FATAL_ERROR "The pext slider attack backend requires PRODIGY_PEXT.")
+  endif()
+  add_compile_definitions(PRODIGY_SLIDER_BACKEND="${PRODIGY_SLIDER_BACKEND}")
+endif()
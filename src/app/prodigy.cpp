@@ -1,14 +1,28 @@
+#include <algorithm>
 #include <boost/program_options.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
 #include <iostream>
 #include <memory>
 #include <optional>
-#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "base/ply.h"
 #include "base/string_utils.h"
+#include "bench/bench.h"
+#include "bench/corpus.h"
 #include "board/position.h"
+#include "movegen/king_danger.h"
 #include "movegen/move_generator.h"
 #include "movegen/perft.h"
+#include "movegen/perft_cache.h"
+#include "movegen/perft_suite.h"
+#include "movegen/slider_backend.h"
 #include "search/random_searcher.h"
 #include "uci/event_loop.h"
 
@@ -20,12 +34,8 @@ struct PerftParams final {
 };
 
 void validate(boost::any& out, const std::vector<std::string>& values, std::optional<PerftParams>*, int) {
-  // NOTE: this regex produces false positives.
-  static const std::regex FEN_REGEX(
-      R"(([PNBRQKpnbrqk1-8]{1,8}\/){7}[PNBRQKpnbrqk1-8]{1,8} [wb] ([KQkq]{1,4}|-) ([a-h][36]|-) \d+ \d+)");
-
   const auto depth = values.size() == 2 ? to_arithmetic<Ply>(values.back()) : std::nullopt;
-  if (!depth.has_value() || !std::regex_match(values.front().begin(), values.front().end(), FEN_REGEX)) {
+  if (!depth.has_value() || !board::Position::is_valid_fen(values.front())) {
     throw boost::program_options::validation_error(boost::program_options::validation_error::invalid_option_value);
   }
 
@@ -39,6 +49,21 @@ void validate(boost::any& out, const std::vector<std::string>& values, std::opti
 
 int main(int argc, char* argv[]) {
   std::optional<prodigy::PerftParams> perft_params;
+  bool compare_king_dangers = false;
+  bool divide = false;
+  std::string perft_suite_path;
+  // Parsed wider than a ply, which program_options would read as a single character.
+  unsigned max_depth = prodigy::MAX_PLY;
+  prodigy::movegen::PerftParallelism perft_parallelism;
+  unsigned split_ply = perft_parallelism.split_ply;
+  std::size_t perft_cache_megabytes = 0;
+  std::size_t corpus_size = 0;
+  std::uint64_t corpus_seed = 0;
+  std::string corpus_format = "fen";
+  std::string corpus_path;
+  std::string input_corpus_path;
+  unsigned corpus_perft_depth = 0;
+  std::string benchmark;
 
   const auto command_line_options = [&] {
     boost::program_options::options_description command_line_options("OPTIONS");
@@ -46,6 +71,33 @@ int main(int argc, char* argv[]) {
     command_line_options.add_options()
         ("help,h", "Print help information.")
         ("perft", boost::program_options::value(&perft_params)->value_name("<FEN> <DEPTH>")->multitoken(), "Run perft.")
+        ("divide", boost::program_options::bool_switch(&divide), "Print the perft leaf count below each root move.")
+        ("perft-suite", boost::program_options::value(&perft_suite_path)->value_name("<EPD>"),
+         "Run perft on every position of a perftsuite-style EPD file, and check the counts expected at each depth.")
+        ("max-depth", boost::program_options::value(&max_depth)->value_name("<PLY>"),
+         "Skip the depths of the perft suite deeper than this.")
+        ("compare-king-dangers", boost::program_options::bool_switch(&compare_king_dangers),
+         "Run perft once with each way of finding the squares attacked around the king.")
+        ("threads", boost::program_options::value(&perft_parallelism.thread_count)->value_name("<N>"),
+         "Run perft on N threads. A perft suite runs on every core unless this is given.")
+        ("split-ply", boost::program_options::value(&split_ply)->value_name("<PLY>"),
+         "Split the perft tree into work items for the threads at this ply.")
+        ("perft-hash", boost::program_options::value(&perft_cache_megabytes)->value_name("<MB>"),
+         "Cache the leaf counts of perft subtrees in a table of this size.")
+        ("generate-corpus", boost::program_options::value(&corpus_size)->value_name("<N>"),
+         "Write N positions reached by seeded random games, for benchmarks to run over.")
+        ("seed", boost::program_options::value(&corpus_seed)->value_name("<SEED>"),
+         "Seed the random games of the corpus.")
+        ("corpus-format", boost::program_options::value(&corpus_format)->value_name("<FORMAT>"),
+         "Read or write the corpus as fen or binary.")
+        ("output", boost::program_options::value(&corpus_path)->value_name("<PATH>"),
+         "Write the corpus to this file instead of standard output.")
+        ("corpus", boost::program_options::value(&input_corpus_path)->value_name("<PATH>"),
+         "Run the benchmark, or perft with --corpus-perft, over the positions of this corpus.")
+        ("corpus-perft", boost::program_options::value(&corpus_perft_depth)->value_name("<DEPTH>"),
+         "Run perft to this depth on every position of the corpus.")
+        ("bench", boost::program_options::value(&benchmark)->value_name("<NAME>"),
+         "Run a benchmark: attack-maps, make-unmake, see, slider-backends.")
         ;
     // clang-format on
     return command_line_options;
@@ -63,10 +115,134 @@ int main(int argc, char* argv[]) {
     return 0;
   }
 
+  if (!prodigy::movegen::is_supported(prodigy::movegen::SLIDER_BACKEND)) {
+    std::cerr << "This CPU cannot run the " << prodigy::movegen::SLIDER_BACKEND
+              << " slider attack backend that this build uses.\n";
+    return 1;
+  }
+
+  if (perft_parallelism.thread_count == 0 || split_ply > prodigy::MAX_PLY || max_depth > prodigy::MAX_PLY ||
+      corpus_perft_depth > prodigy::MAX_PLY) {
+    std::cerr << "The number of threads must be positive, and plies at most " << +prodigy::MAX_PLY << ".\n";
+    return 1;
+  }
+  perft_parallelism.split_ply = static_cast<prodigy::Ply>(split_ply);
+
+  if (variables_map.contains("perft-suite")) {
+    std::ifstream perft_suite(perft_suite_path);
+    if (!perft_suite) {
+      std::cerr << "Cannot open perft suite: " << perft_suite_path << '\n';
+      return 1;
+    }
+    std::optional<prodigy::movegen::PerftCache> perft_cache;
+    if (perft_cache_megabytes > 0) {
+      perft_cache.emplace(perft_cache_megabytes);
+    }
+    const auto thread_count = variables_map.contains("threads") ? perft_parallelism.thread_count
+                                                                : std::max(std::thread::hardware_concurrency(), 1U);
+    return run_perft_suite(prodigy::movegen::MoveGenerator(), perft_suite, std::cout, thread_count,
+                           static_cast<prodigy::Ply>(max_depth), perft_cache.has_value() ? &*perft_cache : nullptr)
+               ? 0
+               : 1;
+  }
+
+  const auto format = prodigy::bench::to_corpus_format(corpus_format);
+  if (!format.has_value()) {
+    std::cerr << "Unknown corpus format: " << corpus_format << '\n';
+    return 1;
+  }
+
+  if (variables_map.contains("generate-corpus")) {
+    const auto thread_count = variables_map.contains("threads") ? perft_parallelism.thread_count
+                                                                : std::max(std::thread::hardware_concurrency(), 1U);
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto corpus = prodigy::bench::generate_corpus(corpus_size, corpus_seed, thread_count);
+    const std::chrono::duration<double> runtime = std::chrono::steady_clock::now() - start_time;
+    if (corpus_path.empty()) {
+      write_corpus(std::cout, corpus, *format);
+    } else {
+      std::ofstream output(corpus_path, std::ios::binary);
+      write_corpus(output, corpus, *format);
+      if (!output) {
+        std::cerr << "Cannot write corpus: " << corpus_path << '\n';
+        return 1;
+      }
+    }
+    std::cerr << "Generated " << corpus.size() << " positions in " << runtime.count() << "s\n";
+    return 0;
+  }
+
+  std::optional<std::vector<prodigy::board::Position>> corpus;
+  if (variables_map.contains("corpus")) {
+    std::ifstream input(input_corpus_path, std::ios::binary);
+    if (!input) {
+      std::cerr << "Cannot open corpus: " << input_corpus_path << '\n';
+      return 1;
+    }
+    corpus = prodigy::bench::read_corpus(input, *format);
+    if (!corpus.has_value() || corpus->empty()) {
+      std::cerr << "Cannot read " << *format << " corpus: " << input_corpus_path << '\n';
+      return 1;
+    }
+  }
+
+  if (variables_map.contains("corpus-perft")) {
+    if (!corpus.has_value()) {
+      std::cerr << "Perft over a corpus needs --corpus.\n";
+      return 1;
+    }
+    std::optional<prodigy::movegen::PerftCache> perft_cache;
+    if (perft_cache_megabytes > 0) {
+      perft_cache.emplace(perft_cache_megabytes);
+    }
+    const auto thread_count = variables_map.contains("threads") ? perft_parallelism.thread_count
+                                                                : std::max(std::thread::hardware_concurrency(), 1U);
+    prodigy::bench::perft_corpus(prodigy::movegen::MoveGenerator(), *corpus, std::cout,
+                                 static_cast<prodigy::Ply>(corpus_perft_depth), thread_count,
+                                 perft_cache.has_value() ? &*perft_cache : nullptr);
+    return 0;
+  }
+
   if (perft_params.has_value()) {
-    const auto result = perft(prodigy::movegen::MoveGenerator(), perft_params->position, perft_params->depth);
+    std::optional<prodigy::movegen::PerftCache> perft_cache;
+    std::vector<prodigy::movegen::KingDanger> king_dangers;
+    if (compare_king_dangers) {
+      king_dangers.assign(prodigy::movegen::KING_DANGERS.begin(), prodigy::movegen::KING_DANGERS.end());
+    } else {
+      king_dangers.push_back(prodigy::movegen::KingDanger::LAZY);
+    }
     std::cout << '\n' << perft_params->position << '\n';
-    std::cout << '\n' << result << '\n';
+    for (const auto king_danger : king_dangers) {
+      // Each run starts from an empty cache, so that the runs are comparable.
+      if (perft_cache_megabytes > 0) {
+        perft_cache.emplace(perft_cache_megabytes);
+      }
+      const prodigy::movegen::MoveGenerator move_generator(king_danger);
+      auto* const cache = perft_cache.has_value() ? &*perft_cache : nullptr;
+      std::cout << "\n  Backend: " << prodigy::movegen::SLIDER_BACKEND << "\n  King danger: " << king_danger << '\n';
+      if (!divide || perft_params->depth == 0) {
+        std::cout << perft(move_generator, perft_params->position, perft_params->depth,
+                           prodigy::movegen::PerftStrategy::COPY_MAKE, perft_parallelism, cache)
+                  << '\n';
+        continue;
+      }
+      std::uint64_t leaf_count_sum = 0;
+      for (const auto& [move, leaf_count] :
+           prodigy::movegen::divide(move_generator, perft_params->position, perft_params->depth,
+                                    prodigy::movegen::PerftStrategy::COPY_MAKE, perft_parallelism, cache)) {
+        std::cout << ' ' << move << ": " << leaf_count << '\n';
+        leaf_count_sum += leaf_count;
+      }
+      std::cout << "\n  Nodes: " << leaf_count_sum << '\n';
+    }
+    return 0;
+  }
+
+  if (variables_map.contains("bench")) {
+    if (!prodigy::bench::run(benchmark, std::cout, corpus.has_value() ? &*corpus : nullptr)) {
+      std::cerr << "Unknown benchmark: " << benchmark << '\n';
+      return 1;
+    }
     return 0;
   }
 
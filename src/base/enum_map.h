@@ -27,6 +27,8 @@ class EnumMap final : private std::array<T, N> {
   using Base::begin;
   using Base::end;
 
+  friend constexpr bool operator==(const EnumMap&, const EnumMap&) = default;
+
  private:
   template <typename... Args>
   EnumMap(std::nullptr_t, const Args&... args) : Base(fill_array<T, N>(args...)) {}
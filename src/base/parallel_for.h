@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace prodigy {
+// Calls back once with each index below the count, spread over the threads in turn, and returns once all of them have
+// joined. The callback also takes the thread, numbered below the thread count, so that it can keep state per thread.
+template <std::invocable<unsigned, std::size_t> Callback>
+void parallel_for(const unsigned thread_count, const std::size_t count, const Callback& callback) {
+  std::atomic_size_t next_index = 0;
+  std::vector<std::jthread> threads;
+  threads.reserve(thread_count);
+  for (auto thread = 0U; thread < thread_count; ++thread) {
+    threads.emplace_back([&, thread] {
+      for (auto index = next_index.fetch_add(1, std::memory_order_relaxed); index < count;
+           index = next_index.fetch_add(1, std::memory_order_relaxed)) {
+        callback(thread, index);
+      }
+    });
+  }
+}
+
+template <std::invocable<std::size_t> Callback>
+void parallel_for(const unsigned thread_count, const std::size_t count, const Callback& callback) {
+  parallel_for(thread_count, count, [&](unsigned, const std::size_t index) { callback(index); });
+}
+}
@@ -4,4 +4,6 @@
 
 namespace prodigy {
 using Ply = std::uint8_t;
+
+constexpr Ply MAX_PLY = 128;
 }
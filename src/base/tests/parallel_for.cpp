@@ -0,0 +1,41 @@
+#define BOOST_TEST_MODULE ParallelFor
+
+#include "base/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace prodigy {
+namespace {
+BOOST_AUTO_TEST_CASE(visit_each_index_once) {
+  for (const auto thread_count : {1U, 2U, 7U}) {
+    for (const auto count : {0UZ, 1UZ, 5UZ, 1'000UZ}) {
+      std::vector<std::atomic_int> index_to_visit_count(count);
+      parallel_for(thread_count, count, [&](const auto index) { ++index_to_visit_count[index]; });
+      for (const auto& visit_count : index_to_visit_count) {
+        BOOST_TEST(visit_count == 1);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(number_threads_below_thread_count) {
+  for (const auto thread_count : {1U, 2U, 7U}) {
+    // Counted past the end for any thread out of range, since the test tools are not safe to call from the threads.
+    std::vector<std::atomic_int> thread_to_visit_count(thread_count + 1);
+    parallel_for(thread_count, 1'000, [&](const unsigned thread, std::size_t) {
+      ++thread_to_visit_count[std::min(thread, thread_count)];
+    });
+    BOOST_TEST(thread_to_visit_count.back() == 0);
+    auto visit_count = 0;
+    for (const auto& thread_visit_count : thread_to_visit_count) {
+      visit_count += thread_visit_count;
+    }
+    BOOST_TEST(visit_count == 1'000);
+  }
+}
+}
+}
@@ -0,0 +1,126 @@
+#include "bench/attack_maps.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/position.h"
+#include "board/starting_position_fen.h"
+#include "movegen/attack_map.h"
+#include "movegen/move_generator.h"
+#include "movegen/tables.h"
+
+namespace prodigy::bench {
+namespace {
+constexpr std::string_view FENS[] = {
+    board::STARTING_POSITION_FEN,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+constexpr Ply DEPTH = 2;
+constexpr auto CALL_COUNT = 1UZ << 22;
+
+struct Sample final {
+  board::Position parent;
+  board::Position child;
+  movegen::AttackMap parent_attack_map;
+};
+
+template <board::Color ACTIVE_COLOR>
+void collect_moves(const movegen::MoveGenerator& move_generator, const board::Position& position,
+                   const movegen::AttackMap& attack_map, const Ply depth, std::vector<Sample>& samples) {
+  const auto& tables = movegen::Tables::instance();
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+    const auto child = position.apply<ACTIVE_COLOR>(move);
+    samples.push_back({.parent = position, .child = child, .parent_attack_map = attack_map});
+    if (depth > 1) {
+      collect_moves<~ACTIVE_COLOR>(move_generator, child, movegen::AttackMap(tables, child), depth - 1, samples);
+    }
+  }
+}
+
+// Returns the average runtime of each call in nanoseconds.
+template <typename Call>
+double nanoseconds_per_call(const std::vector<Sample>& samples, Call&& call) {
+  std::uint64_t checksum = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  for (auto i = 0UZ; i < CALL_COUNT; ++i) {
+    checksum += call(samples[i % samples.size()]);
+  }
+  const std::chrono::duration<double, std::nano> runtime = std::chrono::steady_clock::now() - start_time;
+  // Keeps the calls from being optimized away.
+  asm volatile("" : : "r"(checksum));
+  return runtime.count() / CALL_COUNT;
+}
+
+// Both colors' attack sets without counts, the way the move generator computes the squares attacked around its king.
+template <board::Color COLOR>
+board::Bitboard attack_set(const movegen::Tables& tables, const board::Position& position) {
+  const auto occupancy = position.occupancy();
+  board::Bitboard attack_set;
+  const auto add_attack_sets = [&]<board::PieceType PIECE_TYPE> {
+    board::for_each_coordinate(position.pieces<COLOR, PIECE_TYPE>(), [&](const auto origin) {
+      attack_set |= tables.attack_set<COLOR, PIECE_TYPE>(origin, occupancy);
+    });
+  };
+  add_attack_sets.template operator()<board::PieceType::PAWN>();
+  add_attack_sets.template operator()<board::PieceType::KNIGHT>();
+  add_attack_sets.template operator()<board::PieceType::BISHOP>();
+  add_attack_sets.template operator()<board::PieceType::ROOK>();
+  add_attack_sets.template operator()<board::PieceType::QUEEN>();
+  add_attack_sets.template operator()<board::PieceType::KING>();
+  return attack_set;
+}
+}
+
+void attack_maps(std::ostream& os, const std::vector<board::Position>* const corpus) {
+  const movegen::MoveGenerator move_generator;
+  const auto& tables = movegen::Tables::instance();
+  std::vector<Sample> samples;
+  const auto collect = [&](const board::Position& position, const Ply depth) {
+    const movegen::AttackMap attack_map(tables, position);
+    position.active_color() == board::Color::WHITE
+        ? collect_moves<board::Color::WHITE>(move_generator, position, attack_map, depth, samples)
+        : collect_moves<board::Color::BLACK>(move_generator, position, attack_map, depth, samples);
+  };
+  if (corpus != nullptr) {
+    for (const auto& position : *corpus) {
+      collect(position, 1);
+    }
+  } else {
+    for (const auto fen : FENS) {
+      collect(board::Position::from_fen(fen), DEPTH);
+    }
+  }
+  if (samples.empty()) {
+    os << "No moves to time\n";
+    return;
+  }
+
+  os << "Moves: " << samples.size() << '\n';
+  os << "Calls: " << CALL_COUNT << "\n\n";
+  os << std::fixed << std::setprecision(2);
+  const auto print = [&](const std::string_view name, const double nanoseconds) {
+    os << std::left << std::setw(28) << name << std::right << std::setw(10) << nanoseconds << " ns\n";
+  };
+  print("Attack sets from scratch", nanoseconds_per_call(samples, [&](const Sample& sample) {
+          return (attack_set<board::Color::WHITE>(tables, sample.child) ^
+                  attack_set<board::Color::BLACK>(tables, sample.child))
+              .underlying();
+        }));
+  print("Attack map from scratch", nanoseconds_per_call(samples, [&](const Sample& sample) {
+          return movegen::AttackMap(tables, sample.child).attack_set<board::Color::WHITE>().underlying();
+        }));
+  print("Attack map update", nanoseconds_per_call(samples, [&](const Sample& sample) {
+          auto attack_map = sample.parent_attack_map;
+          attack_map.update(tables, sample.parent, sample.child);
+          return attack_map.attack_set<board::Color::WHITE>().underlying();
+        }));
+}
+}
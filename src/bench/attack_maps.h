@@ -0,0 +1,13 @@
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+#include "board/position.h"
+
+namespace prodigy::bench {
+// Times updating attack maps incrementally for a move against computing them from scratch, and against the plain attack
+// sets that the move generator computes for its king, over every move near the root of a few perft positions, or over
+// every move from the positions of the corpus.
+void attack_maps(std::ostream&, const std::vector<board::Position>* corpus = nullptr);
+}
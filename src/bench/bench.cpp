@@ -0,0 +1,28 @@
+#include "bench/bench.h"
+
+#include "bench/attack_maps.h"
+#include "bench/make_unmake.h"
+#include "bench/see.h"
+#include "bench/slider_backends.h"
+
+namespace prodigy::bench {
+bool run(const std::string_view name, std::ostream& os, const std::vector<board::Position>* const corpus) {
+  if (name == "attack-maps") {
+    attack_maps(os, corpus);
+    return true;
+  }
+  if (name == "make-unmake") {
+    make_unmake(os, corpus);
+    return true;
+  }
+  if (name == "see") {
+    see(os, corpus);
+    return true;
+  }
+  if (name == "slider-backends") {
+    slider_backends(os, corpus);
+    return true;
+  }
+  return false;
+}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+#include "board/position.h"
+
+namespace prodigy::bench {
+// Runs the named benchmark, reporting its results to the stream. Runs over the positions of the corpus instead of the
+// benchmark's own if there is one. Returns false if there is no such benchmark.
+bool run(std::string_view name, std::ostream&, const std::vector<board::Position>* corpus = nullptr);
+}
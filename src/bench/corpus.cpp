@@ -0,0 +1,226 @@
+#include "bench/corpus.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <boost/assert.hpp>
+#include <chrono>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "base/parallel_for.h"
+#include "base/ply.h"
+#include "board/castling_rights.h"
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/piece.h"
+#include "board/piece_type.h"
+#include "movegen/perft.h"
+#include "search/random_searcher.h"
+
+namespace prodigy::bench {
+namespace {
+// Long enough for most games to reach an endgame, which random play does quickly.
+constexpr Ply MAX_PLAYOUT_PLIES = 160;
+constexpr auto POSITIONS_PER_WORK_ITEM = 1UZ << 10;
+constexpr auto RECORD_SIZE = 32UZ;
+
+using Record = std::array<std::uint8_t, RECORD_SIZE>;
+
+board::Position playout(search::RandomSearcher& random_searcher, const std::uint64_t seed, const std::size_t index) {
+  std::seed_seq seed_sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                              static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32)};
+  std::mt19937_64 engine(seed_sequence);
+  // Keeps the corpus to positions that have moves to generate, by stepping back from the end of a finished game.
+  auto previous = board::Position::starting_position();
+  auto position = previous;
+  for (auto plies = std::uniform_int_distribution<int>(1, MAX_PLAYOUT_PLIES)(engine); plies > 0; --plies) {
+    const auto move = random_searcher.choose_move(position, engine);
+    if (!move.has_value()) {
+      return previous;
+    }
+    previous = position;
+    position = position.active_color() == board::Color::WHITE ? position.apply<board::Color::WHITE>(*move)
+                                                              : position.apply<board::Color::BLACK>(*move);
+  }
+  return random_searcher.choose_move(position, engine).has_value() ? position : previous;
+}
+
+Record encode(const board::Position& position) {
+  Record record{};
+  const auto occupancy = position.occupancy().underlying();
+  for (auto i = 0UZ; i < 8; ++i) {
+    record[i] = static_cast<std::uint8_t>(occupancy >> (8 * i));
+  }
+  auto nibble = 0UZ;
+  for (auto square = 0; square < 64; ++square) {
+    if (const auto piece = position.piece_at(static_cast<board::Coordinate>(square))) {
+      const auto code = std::to_underlying(piece.piece_type()) << 1 | std::to_underlying(piece.color());
+      record[8 + nibble / 2] |= static_cast<std::uint8_t>(code << (4 * (nibble % 2)));
+      ++nibble;
+    }
+  }
+  record[24] = static_cast<std::uint8_t>(std::to_underlying(position.active_color()) |
+                                         std::to_underlying(position.castling_rights()) << 1);
+  if (const auto en_passant_target = position.en_passant_target(); en_passant_target.has_value()) {
+    record[25] = static_cast<std::uint8_t>(std::to_underlying(*en_passant_target) + 1);
+  }
+  record[26] = position.halfmove_clock();
+  record[27] = static_cast<std::uint8_t>(position.fullmove_number());
+  record[28] = static_cast<std::uint8_t>(position.fullmove_number() >> 8);
+  return record;
+}
+
+std::optional<board::Position> decode(const Record& record) {
+  std::uint64_t occupancy = 0;
+  for (auto i = 0UZ; i < 8; ++i) {
+    occupancy |= std::uint64_t{record[i]} << (8 * i);
+  }
+  if (std::popcount(occupancy) > 32 || record[25] > 64) {
+    return std::nullopt;
+  }
+  // Goes through FEN so that the position is built the one way every other position is.
+  std::ostringstream fen;
+  for (auto rank = 7; rank >= 0; --rank) {
+    auto empty_count = 0;
+    for (auto file = 0; file < 8; ++file) {
+      const auto square = 8 * rank + file;
+      if (!(occupancy >> square & 1)) {
+        ++empty_count;
+        continue;
+      }
+      // The pieces are packed in coordinate order, so this one follows every piece on a lower square.
+      const auto nibble = static_cast<std::size_t>(std::popcount(occupancy & ((std::uint64_t{1} << square) - 1)));
+      const auto code = record[8 + nibble / 2] >> (4 * (nibble % 2)) & 0xF;
+      if (code >= 12) {
+        return std::nullopt;
+      }
+      if (empty_count != 0) {
+        fen << empty_count;
+        empty_count = 0;
+      }
+      fen << board::Piece(static_cast<board::Color>(code & 1), static_cast<board::PieceType>(code >> 1));
+    }
+    if (empty_count != 0) {
+      fen << empty_count;
+    }
+    fen << (rank != 0 ? '/' : ' ');
+  }
+  fen << static_cast<board::Color>(record[24] & 1) << ' ' << static_cast<board::CastlingRights>(record[24] >> 1 & 0xF)
+      << ' ';
+  if (record[25] != 0) {
+    fen << static_cast<board::Coordinate>(record[25] - 1);
+  } else {
+    fen << '-';
+  }
+  fen << ' ' << +record[26] << ' ' << (record[27] | record[28] << 8);
+  if (!board::Position::is_valid_fen(fen.str())) {
+    return std::nullopt;
+  }
+  return board::Position::from_fen(fen.str());
+}
+}
+
+std::vector<board::Position> generate_corpus(const std::size_t count, const std::uint64_t seed,
+                                             const unsigned thread_count) {
+  BOOST_ASSERT(thread_count > 0);
+  std::vector<board::Position> corpus(count, board::Position::starting_position());
+  // Each thread reuses one searcher, whose stack is too large to set up per work item.
+  std::vector<std::unique_ptr<search::RandomSearcher>> thread_to_random_searcher;
+  thread_to_random_searcher.reserve(thread_count);
+  for (auto thread = 0U; thread < thread_count; ++thread) {
+    thread_to_random_searcher.push_back(std::make_unique<search::RandomSearcher>(seed));
+  }
+  parallel_for(thread_count, (count + POSITIONS_PER_WORK_ITEM - 1) / POSITIONS_PER_WORK_ITEM,
+               [&](const unsigned thread, const std::size_t work_item) {
+                 const auto begin = work_item * POSITIONS_PER_WORK_ITEM;
+                 for (auto i = begin; i < std::min(begin + POSITIONS_PER_WORK_ITEM, count); ++i) {
+                   corpus[i] = playout(*thread_to_random_searcher[thread], seed, i);
+                 }
+               });
+  return corpus;
+}
+
+void write_corpus(std::ostream& os, const std::vector<board::Position>& corpus, const CorpusFormat corpus_format) {
+  for (const auto& position : corpus) {
+    switch (corpus_format) {
+      case CorpusFormat::FEN:
+        os << position.fen() << '\n';
+        break;
+      case CorpusFormat::BINARY: {
+        const auto record = encode(position);
+        os.write(reinterpret_cast<const char*>(record.data()), record.size());
+      } break;
+    }
+  }
+}
+
+std::optional<std::vector<board::Position>> read_corpus(std::istream& is, const CorpusFormat corpus_format) {
+  std::vector<board::Position> corpus;
+  switch (corpus_format) {
+    case CorpusFormat::FEN:
+      for (std::string line; std::getline(is, line);) {
+        if (line.empty()) {
+          continue;
+        }
+        if (!board::Position::is_valid_fen(line)) {
+          return std::nullopt;
+        }
+        corpus.push_back(board::Position::from_fen(line));
+      }
+      break;
+    case CorpusFormat::BINARY:
+      for (Record record; is.read(reinterpret_cast<char*>(record.data()), record.size());) {
+        auto position = decode(record);
+        if (!position.has_value()) {
+          return std::nullopt;
+        }
+        corpus.push_back(*std::move(position));
+      }
+      if (is.gcount() != 0) {
+        return std::nullopt;
+      }
+      break;
+  }
+  return corpus;
+}
+
+void perft_corpus(const movegen::MoveGenerator& move_generator, const std::vector<board::Position>& corpus,
+                  std::ostream& os, const Ply depth, const unsigned thread_count, movegen::PerftCache* const cache) {
+  BOOST_ASSERT(thread_count > 0);
+  std::vector<std::uint64_t> leaf_counts(corpus.size());
+  const auto start_time = std::chrono::steady_clock::now();
+  parallel_for(thread_count, corpus.size(), [&](const auto i) {
+    leaf_counts[i] =
+        movegen::perft(move_generator, corpus[i], depth, movegen::PerftStrategy::COPY_MAKE, {}, cache)
+            .depth_to_node_count.back();
+  });
+  const std::chrono::duration<double> runtime = std::chrono::steady_clock::now() - start_time;
+
+  std::uint64_t leaf_count = 0;
+  for (const auto count : leaf_counts) {
+    leaf_count += count;
+  }
+  os << "  Positions: " << corpus.size() << '\n';
+  os << "      Nodes: " << leaf_count << '\n';
+  os << "        NPS: " << std::fixed << leaf_count / runtime.count() << '\n';
+  os << "    Runtime: " << runtime.count() << "s\n";
+}
+
+std::ostream& operator<<(std::ostream& os, const CorpusFormat corpus_format) {
+  switch (corpus_format) {
+    case CorpusFormat::FEN:
+      os << "fen";
+      break;
+    case CorpusFormat::BINARY:
+      os << "binary";
+      break;
+  }
+  return os;
+}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/position.h"
+#include "movegen/move_generator.h"
+#include "movegen/perft_cache.h"
+
+namespace prodigy::bench {
+enum class CorpusFormat : std::uint8_t {
+  // One FEN per line.
+  FEN,
+  // One 32 byte record per position: the occupancy with A1 as its lowest bit, the pieces on it packed into nibbles from
+  // A1 up, and then the active color, castling rights, en passant target, halfmove clock and fullmove number. Little
+  // endian.
+  BINARY,
+};
+
+constexpr std::optional<CorpusFormat> to_corpus_format(const std::string_view corpus_format) {
+  if (corpus_format == "fen") {
+    return CorpusFormat::FEN;
+  }
+  if (corpus_format == "binary") {
+    return CorpusFormat::BINARY;
+  }
+  return std::nullopt;
+}
+
+// Plays a random game from the starting position for each position of the corpus, and keeps where it stops after a
+// random number of plies. Each game is seeded by the seed and its index alone, so the corpus is the same for any
+// number of threads.
+std::vector<board::Position> generate_corpus(std::size_t count, std::uint64_t seed, unsigned thread_count);
+
+void write_corpus(std::ostream&, const std::vector<board::Position>&, CorpusFormat);
+
+// Returns nullopt if the input is not a corpus of the format, including when a position is invalid.
+std::optional<std::vector<board::Position>> read_corpus(std::istream&, CorpusFormat);
+
+// Runs perft to the depth on every position of the corpus, one position per thread at a time, and reports the totals to
+// the output.
+void perft_corpus(const movegen::MoveGenerator&, const std::vector<board::Position>&, std::ostream&, Ply depth,
+                  unsigned thread_count, movegen::PerftCache* = nullptr);
+
+std::ostream& operator<<(std::ostream&, CorpusFormat);
+}
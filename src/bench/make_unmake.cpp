@@ -0,0 +1,142 @@
+#include "bench/make_unmake.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/color.h"
+#include "board/position.h"
+#include "board/starting_position_fen.h"
+#include "board/undo.h"
+#include "movegen/move_generator.h"
+#include "movegen/perft.h"
+#include "search/stack.h"
+#include "zobrist/hash.h"
+
+namespace prodigy::bench {
+namespace {
+struct Workload final {
+  std::string_view name;
+  std::string_view fen;
+  Ply perft_depth;
+  Ply search_depth;
+};
+
+constexpr Workload WORKLOADS[] = {
+    {"startpos", board::STARTING_POSITION_FEN, 6, 5},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 5, 4},
+};
+constexpr Ply CORPUS_PERFT_DEPTH = 3;
+constexpr Ply CORPUS_SEARCH_DEPTH = 3;
+
+struct WalkResult final {
+  std::uint64_t node_count = 0;
+  // Folds in the hash of every node so that making the moves cannot be optimized away.
+  zobrist::Hash checksum = 0;
+};
+
+template <board::Color ACTIVE_COLOR>
+void copy_make_walk(const movegen::MoveGenerator& move_generator, const board::Position& position,
+                    search::Stack& stack, const Ply ply, const Ply depth, WalkResult& result) {
+  auto& frame = stack[ply];
+  frame.check_info = move_generator.check_info<ACTIVE_COLOR>(position);
+  auto* const moves = frame.moves.data();
+  const auto* const moves_end = move_generator.generate<ACTIVE_COLOR>(position, frame.check_info, moves);
+  for (const auto* it = moves; it != moves_end; ++it) {
+    const auto child = position.apply<ACTIVE_COLOR>(it->move);
+    ++result.node_count;
+    result.checksum ^= child.hash();
+    if (ply + 1 < depth) {
+      copy_make_walk<~ACTIVE_COLOR>(move_generator, child, stack, ply + 1, depth, result);
+    }
+  }
+}
+
+template <board::Color ACTIVE_COLOR>
+void make_unmake_walk(const movegen::MoveGenerator& move_generator, board::Position& position, search::Stack& stack,
+                      const Ply ply, const Ply depth, WalkResult& result) {
+  auto& frame = stack[ply];
+  frame.check_info = move_generator.check_info<ACTIVE_COLOR>(position);
+  auto* const moves = frame.moves.data();
+  const auto* const moves_end = move_generator.generate<ACTIVE_COLOR>(position, frame.check_info, moves);
+  for (const auto* it = moves; it != moves_end; ++it) {
+    board::Undo undo;
+    position.make<ACTIVE_COLOR>(it->move, undo);
+    ++result.node_count;
+    result.checksum ^= position.hash();
+    if (ply + 1 < depth) {
+      make_unmake_walk<~ACTIVE_COLOR>(move_generator, position, stack, ply + 1, depth, result);
+    }
+    position.unmake<ACTIVE_COLOR>(it->move, undo);
+  }
+}
+
+// Returns millions of nodes per second over all of the positions.
+double walk_mnps(const movegen::MoveGenerator& move_generator, const std::vector<board::Position>& positions,
+                 const Ply depth, const movegen::PerftStrategy perft_strategy) {
+  const auto stack = std::make_unique<search::Stack>();
+  WalkResult result;
+  const auto start_time = std::chrono::steady_clock::now();
+  for (auto position : positions) {
+    const auto is_white = position.active_color() == board::Color::WHITE;
+    switch (perft_strategy) {
+      case movegen::PerftStrategy::COPY_MAKE:
+        is_white ? copy_make_walk<board::Color::WHITE>(move_generator, position, *stack, 0, depth, result)
+                 : copy_make_walk<board::Color::BLACK>(move_generator, position, *stack, 0, depth, result);
+        break;
+      case movegen::PerftStrategy::MAKE_UNMAKE:
+        is_white ? make_unmake_walk<board::Color::WHITE>(move_generator, position, *stack, 0, depth, result)
+                 : make_unmake_walk<board::Color::BLACK>(move_generator, position, *stack, 0, depth, result);
+        break;
+    }
+  }
+  const std::chrono::duration<double, std::micro> runtime = std::chrono::steady_clock::now() - start_time;
+  asm volatile("" : : "r"(result.checksum));
+  return static_cast<double>(result.node_count) / runtime.count();
+}
+
+double perft_mnps(const movegen::MoveGenerator& move_generator, const std::vector<board::Position>& positions,
+                  const Ply depth, const movegen::PerftStrategy perft_strategy) {
+  std::uint64_t node_count = 0;
+  std::chrono::microseconds runtime{};
+  for (const auto& position : positions) {
+    const auto result = movegen::perft(move_generator, position, depth, perft_strategy);
+    node_count += result.depth_to_node_count.back();
+    runtime += result.runtime;
+  }
+  return static_cast<double>(node_count) / static_cast<double>(runtime.count());
+}
+}
+
+void make_unmake(std::ostream& os, const std::vector<board::Position>* const corpus) {
+  const movegen::MoveGenerator move_generator;
+  os << std::left << std::setw(24) << "Workload (Mnps)" << std::right << std::setw(12) << "Copy-make" << std::setw(14)
+     << "Make/unmake" << '\n';
+  os << std::fixed << std::setprecision(1);
+  const auto print = [&](const std::string_view name, const std::vector<board::Position>& positions,
+                         const Ply perft_depth, const Ply search_depth) {
+    for (const auto is_perft : {true, false}) {
+      const auto depth = is_perft ? perft_depth : search_depth;
+      const auto run = [&](const auto perft_strategy) {
+        return is_perft ? perft_mnps(move_generator, positions, depth, perft_strategy)
+                        : walk_mnps(move_generator, positions, depth, perft_strategy);
+      };
+      os << std::left << std::setw(10) << (is_perft ? "perft" : "search") << std::setw(10) << name << std::setw(4)
+         << static_cast<int>(depth) << std::right << std::setw(12) << run(movegen::PerftStrategy::COPY_MAKE)
+         << std::setw(14) << run(movegen::PerftStrategy::MAKE_UNMAKE) << '\n';
+    }
+  };
+  if (corpus != nullptr) {
+    print("corpus", *corpus, CORPUS_PERFT_DEPTH, CORPUS_SEARCH_DEPTH);
+    return;
+  }
+  for (const auto& [name, fen, perft_depth, search_depth] : WORKLOADS) {
+    print(name, {board::Position::from_fen(fen)}, perft_depth, search_depth);
+  }
+}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+#include "board/position.h"
+
+namespace prodigy::bench {
+// Times copy-make against make/unmake, both in perft, which counts the moves at its last ply without making them, and
+// in a search shaped tree walk, which generates into a search stack and makes every move down to its last ply. The
+// positions of the corpus are walked to shallower depths than the few built in ones.
+void make_unmake(std::ostream&, const std::vector<board::Position>* corpus = nullptr);
+}
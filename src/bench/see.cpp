@@ -0,0 +1,107 @@
+#include "bench/see.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/color.h"
+#include "board/move.h"
+#include "board/position.h"
+#include "movegen/generation_type.h"
+#include "movegen/move_generator.h"
+
+namespace prodigy::bench {
+namespace {
+constexpr std::string_view FENS[] = {
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+constexpr Ply DEPTH = 1;
+constexpr auto CALL_COUNT = 1UZ << 24;
+
+struct Sample final {
+  board::Position position;
+  board::Move move;
+};
+
+template <board::Color ACTIVE_COLOR>
+void collect_captures(const movegen::MoveGenerator& move_generator, const board::Position& position, const Ply depth,
+                      std::vector<Sample>& samples) {
+  for (const auto move : move_generator.generate<ACTIVE_COLOR, movegen::GenerationType::CAPTURES>(position)) {
+    samples.push_back({.position = position, .move = move});
+  }
+  if (depth == 0) {
+    return;
+  }
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+    collect_captures<~ACTIVE_COLOR>(move_generator, position.apply<ACTIVE_COLOR>(move), depth - 1, samples);
+  }
+}
+
+// Returns the average runtime of each call in nanoseconds.
+template <typename Call>
+double nanoseconds_per_call(const std::vector<Sample>& samples, Call&& call) {
+  std::uint64_t checksum = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  for (auto i = 0UZ; i < CALL_COUNT; ++i) {
+    checksum += call(samples[i % samples.size()]);
+  }
+  const std::chrono::duration<double, std::nano> runtime = std::chrono::steady_clock::now() - start_time;
+  // Keeps the calls from being optimized away.
+  asm volatile("" : : "r"(checksum));
+  return runtime.count() / CALL_COUNT;
+}
+}
+
+void see(std::ostream& os, const std::vector<board::Position>* const corpus) {
+  const movegen::MoveGenerator move_generator;
+  std::vector<Sample> samples;
+  const auto collect = [&](const board::Position& position, const Ply depth) {
+    position.active_color() == board::Color::WHITE
+        ? collect_captures<board::Color::WHITE>(move_generator, position, depth, samples)
+        : collect_captures<board::Color::BLACK>(move_generator, position, depth, samples);
+  };
+  if (corpus != nullptr) {
+    for (const auto& position : *corpus) {
+      collect(position, 0);
+    }
+  } else {
+    for (const auto fen : FENS) {
+      collect(board::Position::from_fen(fen), DEPTH);
+    }
+  }
+  if (samples.empty()) {
+    os << "No captures to time\n";
+    return;
+  }
+  const auto see_ge = [&](const Sample& sample) {
+    return sample.position.active_color() == board::Color::WHITE
+               ? move_generator.see_ge<board::Color::WHITE>(sample.position, sample.move, 0)
+               : move_generator.see_ge<board::Color::BLACK>(sample.position, sample.move, 0);
+  };
+  auto losing_capture_count = 0UZ;
+  for (const auto& sample : samples) {
+    losing_capture_count += !see_ge(sample);
+  }
+
+  os << "Captures       : " << samples.size() << '\n';
+  os << "Losing captures: " << losing_capture_count << '\n';
+  os << "Calls          : " << CALL_COUNT << "\n\n";
+  os << std::fixed << std::setprecision(2);
+  os << std::left << std::setw(16) << "attackers_to" << std::right << std::setw(10)
+     << nanoseconds_per_call(samples,
+                             [&](const Sample& sample) {
+                               return move_generator
+                                   .attackers_to(sample.position, sample.move.target(), sample.position.occupancy())
+                                   .underlying();
+                             })
+     << " ns\n";
+  os << std::left << std::setw(16) << "see_ge" << std::right << std::setw(10)
+     << nanoseconds_per_call(samples, [&](const Sample& sample) { return see_ge(sample); }) << " ns\n";
+}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+#include "board/position.h"
+
+namespace prodigy::bench {
+// Times static exchange evaluation and the attackers_to lookup it is built on, over every capture near the root of a
+// few tactical positions, or over every capture in the positions of the corpus.
+void see(std::ostream&, const std::vector<board::Position>* corpus = nullptr);
+}
@@ -0,0 +1,140 @@
+#include "bench/slider_backends.h"
+
+#include <bit>
+#include <boost/assert.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/piece_type.h"
+#include "board/position.h"
+#include "movegen/slider_backend.h"
+#include "movegen/tables.h"
+#include "transposition_table/key.h"
+#include "transposition_table/transposition_table.h"
+
+namespace prodigy::bench {
+namespace {
+constexpr auto SAMPLE_COUNT = 1UZ << 12;
+constexpr auto LOOKUP_COUNT = 1UZ << 24;
+constexpr auto TRANSPOSITION_TABLE_MEGABYTES = 256UZ;
+
+struct Sample final {
+  board::Coordinate origin;
+  board::Bitboard occupancy;
+};
+
+std::vector<Sample> random_samples() {
+  // Seeded so that every run and every backend looks up the same attack sets.
+  std::mt19937_64 engine(0);
+  std::vector<Sample> samples(SAMPLE_COUNT);
+  for (auto& [origin, occupancy] : samples) {
+    origin = static_cast<board::Coordinate>(engine() % 64);
+    occupancy = std::bit_cast<board::Bitboard>(engine() & engine());
+  }
+  return samples;
+}
+
+// The coordinate of every piece in the corpus, with the occupancy of its position.
+std::vector<Sample> corpus_samples(const std::vector<board::Position>& corpus) {
+  std::vector<Sample> samples;
+  for (const auto& position : corpus) {
+    board::for_each_coordinate(position.occupancy(), [&](const auto origin) {
+      samples.push_back({.origin = origin, .occupancy = position.occupancy()});
+    });
+  }
+  return samples;
+}
+
+// Returns the average runtime of each lookup in nanoseconds. Probing the transposition table at pseudorandom keys
+// streams through far more memory than fits in cache.
+template <typename AttackSet>
+double nanoseconds_per_lookup(AttackSet&& attack_set,
+                              transposition_table::TranspositionTable* const transposition_table,
+                              const std::vector<Sample>& samples) {
+  transposition_table::Key key = 0;
+  std::uint64_t checksum = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  for (auto i = 0UZ; i < LOOKUP_COUNT; ++i) {
+    const auto& [origin, occupancy] = samples[i % samples.size()];
+    checksum += attack_set(origin, occupancy);
+    if (transposition_table != nullptr) {
+      key = key * 6'364'136'223'846'793'005 + 1'442'695'040'888'963'407;
+      checksum += transposition_table->find(key).has_value();
+    }
+  }
+  const std::chrono::duration<double, std::nano> runtime = std::chrono::steady_clock::now() - start_time;
+  // Keeps the lookups from being optimized away.
+  asm volatile("" : : "r"(checksum));
+  return runtime.count() / LOOKUP_COUNT;
+}
+
+// Everywhere else the slider backend is fixed at build time, so this is the one place that picks it at runtime.
+double nanoseconds_per_lookup(const movegen::SliderBackend slider_backend,
+                              transposition_table::TranspositionTable* const transposition_table,
+                              const std::vector<Sample>& samples) {
+  BOOST_ASSERT(is_supported(slider_backend));
+  const auto& tables = movegen::Tables::instance();
+  const auto time = [&]<movegen::SliderBackend SLIDER_BACKEND> {
+    return nanoseconds_per_lookup(
+        [&](const board::Coordinate origin, const board::Bitboard occupancy) {
+          return tables.attack_set<board::Color::WHITE, board::PieceType::QUEEN, SLIDER_BACKEND>(origin, occupancy)
+              .underlying();
+        },
+        transposition_table, samples);
+  };
+  switch (slider_backend) {
+    case movegen::SliderBackend::MAGIC:
+      return time.template operator()<movegen::SliderBackend::MAGIC>();
+    case movegen::SliderBackend::PEXT:
+#ifdef PRODIGY_PEXT
+      return time.template operator()<movegen::SliderBackend::PEXT>();
+#else
+      break;
+#endif
+    case movegen::SliderBackend::HYPERBOLA_QUINTESSENCE:
+      return time.template operator()<movegen::SliderBackend::HYPERBOLA_QUINTESSENCE>();
+  }
+  __builtin_unreachable();
+}
+}
+
+void slider_backends(std::ostream& os, const std::vector<board::Position>* const corpus) {
+  const auto samples = corpus != nullptr ? corpus_samples(*corpus) : random_samples();
+  if (samples.empty()) {
+    os << "No lookups to time\n";
+    return;
+  }
+  transposition_table::TranspositionTable transposition_table(TRANSPOSITION_TABLE_MEGABYTES);
+
+  os << "Queen attack set lookups: " << LOOKUP_COUNT << '\n';
+  os << "Transposition table     : " << TRANSPOSITION_TABLE_MEGABYTES << " MB\n";
+  os << "Built with              : " << movegen::SLIDER_BACKEND << "\n\n";
+  os << std::left << std::setw(12) << "Backend" << std::right << std::setw(16) << "Isolated (ns)" << std::setw(20)
+     << "Streaming TT (ns)" << std::setw(20) << "Slider share (ns)" << '\n';
+
+  const auto probe_nanoseconds =
+      nanoseconds_per_lookup([](board::Coordinate, board::Bitboard) { return std::uint64_t{0}; }, &transposition_table,
+                             samples);
+  os << std::fixed << std::setprecision(2);
+  os << std::left << std::setw(12) << "none" << std::right << std::setw(16) << '-' << std::setw(20)
+     << probe_nanoseconds << std::setw(20) << '-' << '\n';
+
+  for (const auto slider_backend : movegen::SLIDER_BACKENDS) {
+    if (!is_supported(slider_backend)) {
+      continue;
+    }
+    const auto isolated_nanoseconds = nanoseconds_per_lookup(slider_backend, nullptr, samples);
+    const auto streaming_nanoseconds = nanoseconds_per_lookup(slider_backend, &transposition_table, samples);
+    os << std::left << std::setw(12) << slider_backend << std::right << std::setw(16) << isolated_nanoseconds
+       << std::setw(20) << streaming_nanoseconds << std::setw(20) << streaming_nanoseconds - probe_nanoseconds << '\n';
+  }
+}
+}
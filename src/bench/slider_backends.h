@@ -0,0 +1,13 @@
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+#include "board/position.h"
+
+namespace prodigy::bench {
+// Times queen attack set lookups with each supported slider backend, both on their own and interleaved with probes of
+// a large transposition table, which evict the attack tables from cache the way a search does. Looks up random
+// coordinates and occupancies, or the coordinate of every piece in the corpus with the occupancy around it.
+void slider_backends(std::ostream&, const std::vector<board::Position>* corpus = nullptr);
+}
@@ -0,0 +1,78 @@
+#define BOOST_TEST_MODULE Corpus
+
+#include "bench/corpus.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "board/position.h"
+
+namespace prodigy::bench {
+namespace {
+// More than one work item's worth, so that several threads each generate part of it.
+constexpr auto CORPUS_SIZE = 2'100UZ;
+
+std::string write(const std::vector<board::Position>& corpus, const CorpusFormat corpus_format) {
+  std::ostringstream os;
+  write_corpus(os, corpus, corpus_format);
+  return os.str();
+}
+
+BOOST_AUTO_TEST_CASE(round_trip) {
+  auto corpus = generate_corpus(CORPUS_SIZE, 1, 1);
+  corpus.push_back(board::Position::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+  corpus.push_back(board::Position::from_fen("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"));
+  corpus.push_back(board::Position::from_fen("8/8/4k3/8/8/4K3/8/8 b - - 99 300"));
+  for (const auto corpus_format : {CorpusFormat::FEN, CorpusFormat::BINARY}) {
+    BOOST_TEST_CONTEXT(corpus_format) {
+      const auto serialized = write(corpus, corpus_format);
+      if (corpus_format == CorpusFormat::BINARY) {
+        BOOST_TEST(serialized.size() == 32 * corpus.size());
+      }
+      std::istringstream is(serialized);
+      const auto read = read_corpus(is, corpus_format);
+      BOOST_TEST_REQUIRE(read.has_value());
+      BOOST_TEST_REQUIRE(read->size() == corpus.size());
+      for (auto i = 0UZ; i < corpus.size(); ++i) {
+        BOOST_TEST((*read)[i].fen() == corpus[i].fen());
+        BOOST_TEST((*read)[i].hash() == corpus[i].hash());
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(same_for_any_thread_count) {
+  const auto expected = write(generate_corpus(CORPUS_SIZE, 42, 1), CorpusFormat::BINARY);
+  for (const auto thread_count : {2U, 3U}) {
+    BOOST_TEST_CONTEXT("threads " << thread_count) {
+      BOOST_TEST(write(generate_corpus(CORPUS_SIZE, 42, thread_count), CorpusFormat::BINARY) == expected);
+    }
+  }
+  BOOST_TEST(write(generate_corpus(CORPUS_SIZE, 43, 1), CorpusFormat::BINARY) != expected);
+}
+
+BOOST_AUTO_TEST_CASE(invalid) {
+  std::istringstream fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1\nrnbqkbnr/pppppppp w KQkq - 0 1\n");
+  BOOST_TEST(!read_corpus(fen, CorpusFormat::FEN).has_value());
+
+  const auto binary = write({board::Position::starting_position()}, CorpusFormat::BINARY);
+  std::istringstream truncated(binary.substr(0, binary.size() - 1));
+  BOOST_TEST(!read_corpus(truncated, CorpusFormat::BINARY).has_value());
+
+  // Turns the white king on E1, the fifth piece from A1, into a queen.
+  auto without_king = binary;
+  without_king[10] = static_cast<char>((without_king[10] & 0xF0) | 0x08);
+  std::istringstream kingless(without_king);
+  BOOST_TEST(!read_corpus(kingless, CorpusFormat::BINARY).has_value());
+
+  // A piece code past the black king.
+  auto unknown_piece = binary;
+  unknown_piece[10] = static_cast<char>((unknown_piece[10] & 0xF0) | 0x0C);
+  std::istringstream unknown(unknown_piece);
+  BOOST_TEST(!read_corpus(unknown, CorpusFormat::BINARY).has_value());
+}
+}
+}
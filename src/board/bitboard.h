@@ -8,6 +8,8 @@
 #include <utility>
 
 #include "board/coordinate.h"
+#include "board/direction.h"
+#include "board/rank.h"
 
 namespace prodigy::board {
 class Bitboard final {
@@ -16,6 +18,8 @@ class Bitboard final {
 
   constexpr explicit Bitboard(const Coordinate coordinate) : data_(1ULL << std::to_underlying(coordinate)) {}
 
+  constexpr explicit Bitboard(const Rank rank) : data_(0xFFULL << 8 * std::to_underlying(rank)) {}
+
   constexpr std::uint64_t underlying() const { return data_; }
 
   constexpr auto popcount() const { return std::popcount(data_); }
@@ -43,6 +47,28 @@ class Bitboard final {
 
   constexpr void pop_lsb() { data_ &= data_ - 1; }
 
+  // Moves every bit one step in the direction, dropping the bits which would leave the board.
+  template <Direction DIRECTION>
+  constexpr Bitboard shift() const {
+    constexpr auto OFFSET = std::to_underlying(DIRECTION);
+    constexpr auto NOT_FILE_A = 0xFEFEFEFEFEFEFEFEULL;
+    constexpr auto NOT_FILE_H = 0x7F7F7F7F7F7F7F7FULL;
+    const auto data = OFFSET > 0 ? data_ << OFFSET : data_ >> -OFFSET;
+    if constexpr (DIRECTION == Direction::EAST || DIRECTION == Direction::NORTH_EAST ||
+                  DIRECTION == Direction::SOUTH_EAST) {
+      return Bitboard(data & NOT_FILE_A);
+    } else if constexpr (DIRECTION == Direction::WEST || DIRECTION == Direction::NORTH_WEST ||
+                         DIRECTION == Direction::SOUTH_WEST) {
+      return Bitboard(data & NOT_FILE_H);
+    } else {
+      return Bitboard(data);
+    }
+  }
+
+  // Carry-Rippler: the subset of `mask` after this one when counting through the bits of `mask` in binary, wrapping
+  // around to the empty set.
+  constexpr Bitboard next_subset(const Bitboard mask) const { return Bitboard((data_ - mask.data_) & mask.data_); }
+
  private:
   constexpr explicit Bitboard(const std::uint64_t data) : data_(data) {}
 
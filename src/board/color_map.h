@@ -0,0 +1,9 @@
+#pragma once
+
+#include "base/enum_map.h"
+#include "board/color.h"
+
+namespace prodigy::board {
+template <typename T>
+using ColorMap = EnumMap<Color, T, 2>;
+}
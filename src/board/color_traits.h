@@ -17,8 +17,11 @@ struct ColorTraits<Color::WHITE> final {
   static constexpr Rank EN_PASSANT_TARGET_RANK = Rank::THREE;
   static constexpr Rank PAWN_DOUBLE_PUSH_TARGET_RANK = Rank::FOUR;
   static constexpr Rank EN_PASSANT_CAPTURE_ORIGIN_RANK = Rank::FIVE;
+  static constexpr Rank PAWN_PROMOTION_ORIGIN_RANK = Rank::SEVEN;
   static constexpr Rank PAWN_PROMOTION_RANK = Rank::EIGHT;
   static constexpr Direction RELATIVE_NORTH = Direction::NORTH;
+  static constexpr Direction RELATIVE_NORTH_EAST = Direction::NORTH_EAST;
+  static constexpr Direction RELATIVE_NORTH_WEST = Direction::NORTH_WEST;
   static constexpr Direction RELATIVE_SOUTH = Direction::SOUTH;
   static constexpr Coordinate KING_INITIAL_ORIGIN = Coordinate::E1;
   static constexpr Coordinate KING_KINGSIDE_CASTLE_TARGET = Coordinate::G1;
@@ -37,8 +40,11 @@ struct ColorTraits<Color::BLACK> final {
   static constexpr Rank EN_PASSANT_TARGET_RANK = Rank::SIX;
   static constexpr Rank PAWN_DOUBLE_PUSH_TARGET_RANK = Rank::FIVE;
   static constexpr Rank EN_PASSANT_CAPTURE_ORIGIN_RANK = Rank::FOUR;
+  static constexpr Rank PAWN_PROMOTION_ORIGIN_RANK = Rank::TWO;
   static constexpr Rank PAWN_PROMOTION_RANK = Rank::ONE;
   static constexpr Direction RELATIVE_NORTH = Direction::SOUTH;
+  static constexpr Direction RELATIVE_NORTH_EAST = Direction::SOUTH_EAST;
+  static constexpr Direction RELATIVE_NORTH_WEST = Direction::SOUTH_WEST;
   static constexpr Direction RELATIVE_SOUTH = Direction::NORTH;
   static constexpr Coordinate KING_INITIAL_ORIGIN = Coordinate::E8;
   static constexpr Coordinate KING_KINGSIDE_CASTLE_TARGET = Coordinate::G8;
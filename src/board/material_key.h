@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "board/color.h"
+#include "board/piece_type.h"
+
+namespace prodigy::board {
+// The number of pieces of each color and piece type, four bits each in the order of PieceMap. Unlike a hash, two
+// positions share a material key exactly when they have the same material, and the counts can be read back out of it.
+using MaterialKey = std::uint64_t;
+
+// What one piece adds to a material key.
+constexpr MaterialKey material_key_of(const Color color, const PieceType piece_type) {
+  return MaterialKey{1} << 4 * (std::to_underlying(piece_type) << 1 | std::to_underlying(color));
+}
+
+constexpr unsigned piece_count(const MaterialKey material_key, const Color color, const PieceType piece_type) {
+  return static_cast<unsigned>(material_key / material_key_of(color, piece_type) & 0xF);
+}
+}
@@ -11,33 +11,86 @@
 #include "board/piece_type.h"
 
 namespace prodigy::board {
+// Moves from UCI only know their origin, target and promotion. Moves from the move generator, or completed by
+// Position::annotate, also know the piece that moves, the piece they capture and what kind of move they are, so that
+// applying them does not have to look up any pieces.
 class Move final {
  public:
+  enum class Kind : std::uint8_t {
+    NORMAL,
+    DOUBLE_PUSH,
+    EN_PASSANT,
+    CASTLE,
+  };
+
+  // Leaves the move uninitialized, so that buffers of moves are free to create.
+  Move() = default;
+
   constexpr Move(const Coordinate origin, const Coordinate target,
                  const std::optional<PieceType> promotion = std::nullopt)
-      : data_((promotion.has_value() ? std::to_underlying(*promotion) : 0) << 12 | std::to_underlying(origin) << 6 |
-              std::to_underlying(target)) {
+      : data_(static_cast<std::uint32_t>(promotion.has_value() ? std::to_underlying(*promotion) : 0) << 12 |
+              static_cast<std::uint32_t>(std::to_underlying(origin)) << 6 | std::to_underlying(target)) {
     BOOST_ASSERT(!promotion.has_value() || (*promotion != PieceType::PAWN && *promotion != PieceType::KING));
   }
 
+  constexpr Move(const PieceType piece_type, const Coordinate origin, const Coordinate target,
+                 const Kind kind = Kind::NORMAL)
+      : data_(Move(origin, target).data_ | static_cast<std::uint32_t>(std::to_underlying(piece_type)) << 16 |
+              static_cast<std::uint32_t>(std::to_underlying(kind)) << 23) {
+    BOOST_ASSERT((kind != Kind::DOUBLE_PUSH && kind != Kind::EN_PASSANT) || piece_type == PieceType::PAWN);
+    BOOST_ASSERT(kind != Kind::CASTLE || piece_type == PieceType::KING);
+  }
+
   constexpr explicit Move(const std::string_view move)
       : Move(to_coordinate(to_file(move[0]), to_rank(move[1])), to_coordinate(to_file(move[2]), to_rank(move[3])),
              move.size() == 5 ? std::optional(to_piece_type(move.back())) : std::nullopt) {
     BOOST_ASSERT(move.size() == 4 || move.size() == 5);
   }
 
+  [[nodiscard]] constexpr Move with_capture(const PieceType captured) const {
+    BOOST_ASSERT(captured != PieceType::KING);
+    return Move(data_ | CAPTURE_BIT | static_cast<std::uint32_t>(std::to_underlying(captured)) << 19);
+  }
+
+  [[nodiscard]] constexpr Move with_promotion(const PieceType promotion) const {
+    BOOST_ASSERT(piece_type() == PieceType::PAWN && !this->promotion().has_value());
+    BOOST_ASSERT(promotion != PieceType::PAWN && promotion != PieceType::KING);
+    return Move(data_ | static_cast<std::uint32_t>(std::to_underlying(promotion)) << 12);
+  }
+
   constexpr Coordinate origin() const { return static_cast<Coordinate>(data_ >> 6 & 0x3F); }
 
   constexpr Coordinate target() const { return static_cast<Coordinate>(data_ & 0x3F); }
 
   constexpr std::optional<PieceType> promotion() const {
-    return data_ >> 12 ? std::optional(static_cast<PieceType>(data_ >> 12)) : std::nullopt;
+    return data_ >> 12 & 0x7 ? std::optional(static_cast<PieceType>(data_ >> 12 & 0x7)) : std::nullopt;
   }
 
+  constexpr PieceType piece_type() const { return static_cast<PieceType>(data_ >> 16 & 0x7); }
+
+  constexpr bool is_capture() const { return data_ & CAPTURE_BIT; }
+
+  // En passant captures a pawn that is not on the target.
+  constexpr PieceType captured() const {
+    BOOST_ASSERT(is_capture());
+    return static_cast<PieceType>(data_ >> 19 & 0x7);
+  }
+
+  constexpr Kind kind() const { return static_cast<Kind>(data_ >> 23 & 0x3); }
+
+  // Just the origin, target and promotion, which is all that UCI and the transposition table keep.
+  constexpr std::uint16_t compact() const { return static_cast<std::uint16_t>(data_); }
+
+  static constexpr Move from_compact(const std::uint16_t compact) { return Move(std::uint32_t{compact}); }
+
   friend constexpr auto operator<=>(Move, Move) = default;
 
  private:
-  std::uint16_t data_;
+  static constexpr std::uint32_t CAPTURE_BIT = 1 << 22;
+
+  constexpr explicit Move(const std::uint32_t data) : data_(data) {}
+
+  std::uint32_t data_;
 };
 
 std::ostream& operator<<(std::ostream&, Move);
@@ -0,0 +1,12 @@
+#include "board/piece.h"
+
+#include <ostream>
+#include <string_view>
+
+namespace prodigy::board {
+std::ostream& operator<<(std::ostream& os, const Piece piece) {
+  static constexpr std::string_view WHITE_PIECES = "PNBRQK";
+  static constexpr std::string_view BLACK_PIECES = "pnbrqk";
+  return os << (piece.color() == Color::WHITE ? WHITE_PIECES : BLACK_PIECES)[std::to_underlying(piece.piece_type())];
+}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <boost/assert.hpp>
+#include <cstdint>
+#include <iosfwd>
+#include <utility>
+
+#include "board/color.h"
+#include "board/piece_type.h"
+
+namespace prodigy::board {
+// A piece type and its color, or no piece at all, in a byte so that a whole board of them fits in a cache line.
+class Piece final {
+ public:
+  // No piece.
+  constexpr Piece() = default;
+
+  constexpr Piece(const Color color, const PieceType piece_type)
+      : data_(static_cast<std::uint8_t>(std::to_underlying(piece_type) << 1 | std::to_underlying(color))) {}
+
+  constexpr explicit operator bool() const { return data_ != NONE; }
+
+  constexpr Color color() const {
+    BOOST_ASSERT(*this);
+    return static_cast<Color>(data_ & 1);
+  }
+
+  constexpr PieceType piece_type() const {
+    BOOST_ASSERT(*this);
+    return static_cast<PieceType>(data_ >> 1);
+  }
+
+  friend constexpr bool operator==(Piece, Piece) = default;
+
+ private:
+  static constexpr std::uint8_t NONE = 0xFF;
+
+  std::uint8_t data_ = NONE;
+};
+
+// Prints the FEN character of the piece.
+std::ostream& operator<<(std::ostream&, Piece);
+}
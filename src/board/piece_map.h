@@ -22,6 +22,10 @@ class PieceMap : private std::array<T, 12> {
     return (*this)[INDEX<COLOR, PIECE_TYPE>];
   }
 
+  constexpr Base::const_reference get(const Color color, const PieceType piece_type) const {
+    return (*this)[std::to_underlying(piece_type) << 1 | std::to_underlying(color)];
+  }
+
  private:
   using Base::operator[];
 
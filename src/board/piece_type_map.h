@@ -0,0 +1,9 @@
+#pragma once
+
+#include "base/enum_map.h"
+#include "board/piece_type.h"
+
+namespace prodigy::board {
+template <typename T>
+using PieceTypeMap = EnumMap<PieceType, T, 6>;
+}
@@ -1,9 +1,12 @@
 #include "board/position.h"
 
+#include <algorithm>
+#include <array>
 #include <boost/assert.hpp>
 #include <cctype>
 #include <ostream>
 #include <sstream>
+#include <string_view>
 #include <utility>
 
 #include "base/string_utils.h"
@@ -81,6 +84,86 @@ Position Position::from_fen(const std::string_view fen) {
       unsafe_to_arithmetic<decltype(fullmove_number_)>(fullmove_number));
 }
 
+bool Position::is_valid_fen(const std::string_view fen) {
+  const auto fields = split(fen);
+  if (fields.size() != 6) {
+    return false;
+  }
+  const auto ranks = split(fields[0], "/");
+  if (ranks.size() != 8) {
+    return false;
+  }
+  // The piece on each square from A1, or a space if there is none.
+  std::array<char, 64> squares;
+  squares.fill(' ');
+  for (auto rank = 0UZ; rank < 8; ++rank) {
+    auto file = 0UZ;
+    for (const auto placement : ranks[7 - rank]) {
+      if (placement >= '1' && placement <= '8') {
+        file += static_cast<std::size_t>(placement - '0');
+      } else if (std::string_view("PNBRQKpnbrqk").contains(placement)) {
+        if (file < 8) {
+          squares[8 * rank + file] = placement;
+        }
+        ++file;
+      } else {
+        return false;
+      }
+    }
+    if (file != 8) {
+      return false;
+    }
+  }
+  const auto count = [&](const char piece) { return std::ranges::count(squares, piece); };
+  const auto is_white_piece = [](const char piece) { return std::isupper(static_cast<unsigned char>(piece)) != 0; };
+  const auto is_black_piece = [](const char piece) { return std::islower(static_cast<unsigned char>(piece)) != 0; };
+  // Past these counts, promotions alone could not have reached the position, and the material key would overflow.
+  if (count('K') != 1 || count('k') != 1 || count('P') > 8 || count('p') > 8 ||
+      std::ranges::count_if(squares, is_white_piece) > 16 || std::ranges::count_if(squares, is_black_piece) > 16) {
+    return false;
+  }
+  for (auto file = 0UZ; file < 8; ++file) {
+    for (const auto square : {file, 56 + file}) {
+      if (squares[square] == 'P' || squares[square] == 'p') {
+        return false;
+      }
+    }
+  }
+
+  const auto active_color = fields[1];
+  if (active_color != "w" && active_color != "b") {
+    return false;
+  }
+  if (const auto castling_rights = fields[2]; castling_rights != "-") {
+    if (castling_rights.size() > 4) {
+      return false;
+    }
+    for (auto i = 0UZ; i < castling_rights.size(); ++i) {
+      if (!std::string_view("KQkq").contains(castling_rights[i]) ||
+          castling_rights.substr(i + 1).contains(castling_rights[i])) {
+        return false;
+      }
+    }
+  }
+  if (const auto en_passant_target = fields[3]; en_passant_target != "-") {
+    const auto is_white = active_color == "w";
+    if (en_passant_target.size() != 2 || en_passant_target[0] < 'a' || en_passant_target[0] > 'h' ||
+        en_passant_target[1] != (is_white ? '6' : '3')) {
+      return false;
+    }
+    // The pawn that just moved two squares stands in front of the target, and passed over it from the square behind.
+    const auto target = 8UZ * static_cast<std::size_t>(en_passant_target[1] - '1') +
+                        static_cast<std::size_t>(en_passant_target[0] - 'a');
+    const auto in_front = is_white ? target - 8 : target + 8;
+    const auto behind = is_white ? target + 8 : target - 8;
+    if (squares[target] != ' ' || squares[behind] != ' ' || squares[in_front] != (is_white ? 'p' : 'P')) {
+      return false;
+    }
+  }
+  return to_arithmetic<decltype(halfmove_clock_)>(fields[4]).has_value() &&
+         to_arithmetic<decltype(fullmove_number_)>(fields[5]).has_value();
+}
+
 const Position& Position::starting_position() {
   static const auto STARTING_POSITION = Position::from_fen(STARTING_POSITION_FEN);
   return STARTING_POSITION;
@@ -92,30 +175,14 @@ std::string Position::fen() const {
        {Rank::EIGHT, Rank::SEVEN, Rank::SIX, Rank::FIVE, Rank::FOUR, Rank::THREE, Rank::TWO, Rank::ONE}) {
     auto empty_coordinates = 0UZ;
     for (const auto file : {File::A, File::B, File::C, File::D, File::E, File::F, File::G, File::H}) {
-#define _(COLOR, PIECE_TYPE, CHAR)                                \
-  if (const auto mask = Bitboard(to_coordinate(file, rank));      \
-      board_.get<Color::COLOR, PieceType::PIECE_TYPE>() & mask) { \
-    if (empty_coordinates != 0) {                                 \
-      fen << empty_coordinates;                                   \
-      empty_coordinates = 0;                                      \
-    }                                                             \
-    fen << CHAR;                                                  \
-    continue;                                                     \
-  }
-      _(WHITE, PAWN, 'P');
-      _(WHITE, KNIGHT, 'N');
-      _(WHITE, BISHOP, 'B');
-      _(WHITE, ROOK, 'R');
-      _(WHITE, QUEEN, 'Q');
-      _(WHITE, KING, 'K');
-      _(BLACK, PAWN, 'p');
-      _(BLACK, KNIGHT, 'n');
-      _(BLACK, BISHOP, 'b');
-      _(BLACK, ROOK, 'r');
-      _(BLACK, QUEEN, 'q');
-      _(BLACK, KING, 'k');
-#undef _
-
+      if (const auto piece = piece_at(to_coordinate(file, rank))) {
+        if (empty_coordinates != 0) {
+          fen << empty_coordinates;
+          empty_coordinates = 0;
+        }
+        fen << piece;
+        continue;
+      }
       ++empty_coordinates;
     }
     if (empty_coordinates != 0) {
@@ -126,8 +193,8 @@ std::string Position::fen() const {
     }
   }
   fen << ' ' << active_color_ << ' ' << castling_rights_ << ' ';
-  if (en_passant_target_.has_value()) {
-    fen << *en_passant_target_;
+  if (const auto en_passant_target = this->en_passant_target(); en_passant_target.has_value()) {
+    fen << *en_passant_target;
   } else {
     fen << '-';
   }
@@ -142,28 +209,15 @@ std::ostream& operator<<(std::ostream& os, const Position& position) {
   for (const auto rank : {'8', '7', '6', '5', '4', '3', '2', '1'}) {
     os << ' ' << rank << " |";
     for (const auto file : {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'}) {
-      os << ' ' << [&] {
-#define _(COLOR, PIECE_TYPE, REPR)                                               \
-  do {                                                                           \
-    if (const auto mask = Bitboard(to_coordinate(to_file(file), to_rank(rank))); \
-        position.pieces<Color::COLOR, PieceType::PIECE_TYPE>() & mask) {         \
-      return REPR;                                                               \
-    }                                                                            \
-  } while (false)
-        _(WHITE, PAWN, "♙");
-        _(WHITE, KNIGHT, "♘");
-        _(WHITE, BISHOP, "♗");
-        _(WHITE, ROOK, "♖");
-        _(WHITE, QUEEN, "♕");
-        _(WHITE, KING, "♔");
-        _(BLACK, PAWN, "♟︎");
-        _(BLACK, KNIGHT, "♞");
-        _(BLACK, BISHOP, "♝");
-        _(BLACK, ROOK, "♜");
-        _(BLACK, QUEEN, "♛");
-        _(BLACK, KING, "♚");
-#undef _
-        return " ";
+      os << ' ' << [&] -> std::string_view {
+        static constexpr std::array<std::array<std::string_view, 6>, 2> COLOR_TO_PIECE_TYPE_TO_REPR = {{
+            {"♙", "♘", "♗", "♖", "♕", "♔"},
+            {"♟︎", "♞", "♝", "♜", "♛", "♚"},
+        }};
+        const auto piece = position.piece_at(to_coordinate(to_file(file), to_rank(rank)));
+        return piece ? COLOR_TO_PIECE_TYPE_TO_REPR[std::to_underlying(piece.color())]
+                                                  [std::to_underlying(piece.piece_type())]
+                     : " ";
       }() << " |";
     }
     os << ' ' << rank << '\n' << RANK_SEPARATOR;
@@ -186,71 +240,212 @@ std::ostream& operator<<(std::ostream& os, const Position& position) {
 Position::Position(const Board& board, const Color active_color, const CastlingRights castling_rights,
                    const std::optional<Coordinate> en_passant_target, const Ply halfmove_clock,
                    const std::uint16_t fullmove_number)
-    : Position(board, active_color, castling_rights, en_passant_target, halfmove_clock, fullmove_number, [&] {
-        const auto& zobrist_randoms = zobrist::Randoms::instance();
-        zobrist::Hash hash = 0;
+    : Position(
+          board,
+          [&] {
+            ColorMap<Bitboard> color_to_occupancy;
+            color_to_occupancy[Color::WHITE] = board.get<Color::WHITE, PieceType::PAWN>() |
+                                               board.get<Color::WHITE, PieceType::KNIGHT>() |
+                                               board.get<Color::WHITE, PieceType::BISHOP>() |
+                                               board.get<Color::WHITE, PieceType::ROOK>() |
+                                               board.get<Color::WHITE, PieceType::QUEEN>() |
+                                               board.get<Color::WHITE, PieceType::KING>();
+            color_to_occupancy[Color::BLACK] = board.get<Color::BLACK, PieceType::PAWN>() |
+                                               board.get<Color::BLACK, PieceType::KNIGHT>() |
+                                               board.get<Color::BLACK, PieceType::BISHOP>() |
+                                               board.get<Color::BLACK, PieceType::ROOK>() |
+                                               board.get<Color::BLACK, PieceType::QUEEN>() |
+                                               board.get<Color::BLACK, PieceType::KING>();
+            return color_to_occupancy;
+          }(),
+          [&] {
+            CoordinateMap<Piece> mailbox;
+            for_each_coordinate([&](const auto coordinate) {
+#define _(COLOR, PIECE_TYPE)                                                     \
+  if (board.get<Color::COLOR, PieceType::PIECE_TYPE>() & Bitboard(coordinate)) { \
+    mailbox[coordinate] = Piece(Color::COLOR, PieceType::PIECE_TYPE);            \
+  }
+              _(WHITE, PAWN);
+              _(WHITE, KNIGHT);
+              _(WHITE, BISHOP);
+              _(WHITE, ROOK);
+              _(WHITE, QUEEN);
+              _(WHITE, KING);
+              _(BLACK, PAWN);
+              _(BLACK, KNIGHT);
+              _(BLACK, BISHOP);
+              _(BLACK, ROOK);
+              _(BLACK, QUEEN);
+              _(BLACK, KING);
+#undef _
+            });
+            return mailbox;
+          }(),
+          active_color, castling_rights, en_passant_target, halfmove_clock, fullmove_number,
+          [&] {
+            const auto& zobrist_randoms = zobrist::Randoms::instance();
+            zobrist::Hash hash = 0;
 #define _(COLOR, PIECE_TYPE)                                                                         \
   for_each_coordinate(board.get<Color::COLOR, PieceType::PIECE_TYPE>(), [&](const auto coordinate) { \
     hash ^= zobrist_randoms.coordinate_random<Color::COLOR, PieceType::PIECE_TYPE>(coordinate);      \
   })
-        _(WHITE, PAWN);
-        _(WHITE, KNIGHT);
-        _(WHITE, BISHOP);
-        _(WHITE, ROOK);
-        _(WHITE, QUEEN);
-        _(WHITE, KING);
-        _(BLACK, PAWN);
-        _(BLACK, KNIGHT);
-        _(BLACK, BISHOP);
-        _(BLACK, ROOK);
-        _(BLACK, QUEEN);
-        _(BLACK, KING);
+            _(WHITE, PAWN);
+            _(WHITE, KNIGHT);
+            _(WHITE, BISHOP);
+            _(WHITE, ROOK);
+            _(WHITE, QUEEN);
+            _(WHITE, KING);
+            _(BLACK, PAWN);
+            _(BLACK, KNIGHT);
+            _(BLACK, BISHOP);
+            _(BLACK, ROOK);
+            _(BLACK, QUEEN);
+            _(BLACK, KING);
 #undef _
-        if (active_color == Color::WHITE) {
-          hash ^= zobrist_randoms.active_color_random();
-        }
-        hash ^= zobrist_randoms.castling_rights_random(castling_rights);
-        if (en_passant_target.has_value()) {
-          hash ^= zobrist_randoms.en_passant_file_random(file_of(*en_passant_target));
-        }
-        return hash;
-      }()) {
+            if (active_color == Color::WHITE) {
+              hash ^= zobrist_randoms.active_color_random();
+            }
+            hash ^= zobrist_randoms.castling_rights_random(castling_rights);
+            if (en_passant_target.has_value()) {
+              hash ^= zobrist_randoms.en_passant_file_random(file_of(*en_passant_target));
+            }
+            return hash;
+          }(),
+          [&] {
+            const auto& zobrist_randoms = zobrist::Randoms::instance();
+            zobrist::Hash pawn_hash = 0;
+            for_each_coordinate(board.get<Color::WHITE, PieceType::PAWN>(), [&](const auto coordinate) {
+              pawn_hash ^= zobrist_randoms.coordinate_random<Color::WHITE, PieceType::PAWN>(coordinate);
+            });
+            for_each_coordinate(board.get<Color::BLACK, PieceType::PAWN>(), [&](const auto coordinate) {
+              pawn_hash ^= zobrist_randoms.coordinate_random<Color::BLACK, PieceType::PAWN>(coordinate);
+            });
+            return pawn_hash;
+          }(),
+          [&] {
+            MaterialKey material_key = 0;
+            for (const auto color : {Color::WHITE, Color::BLACK}) {
+              for (const auto piece_type : {PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK,
+                                            PieceType::QUEEN, PieceType::KING}) {
+                const auto count = board.get(color, piece_type).popcount();
+                BOOST_ASSERT(count < 16);
+                material_key += static_cast<MaterialKey>(count) * material_key_of(color, piece_type);
+              }
+            }
+            return material_key;
+          }()) {
 }
 
 template <Color ACTIVE_COLOR>
-Position Position::apply(const Move move) const {
+zobrist::Hash Position::hash_after(const Move move) const {
   BOOST_ASSERT(ACTIVE_COLOR == active_color_);
+  BOOST_ASSERT(move == annotate<ACTIVE_COLOR>(Move(move.origin(), move.target(), move.promotion())));
   using ActiveColorTraits = ColorTraits<ACTIVE_COLOR>;
+  using OtherColorTraits = ColorTraits<~ACTIVE_COLOR>;
   const auto& zobrist_randoms = zobrist::Randoms::instance();
-  auto board = board_;
+  auto hash = hash_ ^ zobrist_randoms.active_color_random() ^
+              zobrist_randoms.coordinate_random(ACTIVE_COLOR, move.piece_type(), move.origin()) ^
+              zobrist_randoms.coordinate_random(ACTIVE_COLOR, move.promotion().value_or(move.piece_type()),
+                                                move.target());
+  if (en_passant_target_ != NO_EN_PASSANT_TARGET) {
+    hash ^= zobrist_randoms.en_passant_file_random(file_of(en_passant_target_));
+  }
   auto castling_rights = castling_rights_;
-  std::optional<Coordinate> en_passant_target;
-  auto halfmove_clock = halfmove_clock_ + 1;
-  auto hash =
-      hash_ ^ zobrist_randoms.active_color_random() ^
-      (en_passant_target_.has_value() ? zobrist_randoms.en_passant_file_random(file_of(*en_passant_target_)) : 0);
+  switch (move.kind()) {
+    case Move::Kind::NORMAL:
+      break;
+    case Move::Kind::DOUBLE_PUSH:
+      hash ^= zobrist_randoms.en_passant_file_random(file_of(move.target()));
+      break;
+    case Move::Kind::EN_PASSANT:
+      hash ^= zobrist_randoms.coordinate_random<~ACTIVE_COLOR, PieceType::PAWN>(
+          unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(move.target()));
+      break;
+    case Move::Kind::CASTLE:
+      hash ^= move.target() == ActiveColorTraits::KING_KINGSIDE_CASTLE_TARGET
+                  ? zobrist_randoms.coordinate_random<ACTIVE_COLOR, PieceType::ROOK>(
+                        ActiveColorTraits::KINGSIDE_ROOK_INITIAL_ORIGIN) ^
+                        zobrist_randoms.coordinate_random<ACTIVE_COLOR, PieceType::ROOK>(
+                            ActiveColorTraits::KINGSIDE_ROOK_CASTLE_TARGET)
+                  : zobrist_randoms.coordinate_random<ACTIVE_COLOR, PieceType::ROOK>(
+                        ActiveColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN) ^
+                        zobrist_randoms.coordinate_random<ACTIVE_COLOR, PieceType::ROOK>(
+                            ActiveColorTraits::QUEENSIDE_ROOK_CASTLE_TARGET);
+      break;
+  }
+  if (move.piece_type() == PieceType::KING) {
+    castling_rights &= ~(ActiveColorTraits::KINGSIDE_CASTLING_RIGHTS | ActiveColorTraits::QUEENSIDE_CASTLING_RIGHTS);
+  } else if (move.piece_type() == PieceType::ROOK) {
+    if (move.origin() == ActiveColorTraits::KINGSIDE_ROOK_INITIAL_ORIGIN) {
+      castling_rights &= ~ActiveColorTraits::KINGSIDE_CASTLING_RIGHTS;
+    } else if (move.origin() == ActiveColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN) {
+      castling_rights &= ~ActiveColorTraits::QUEENSIDE_CASTLING_RIGHTS;
+    }
+  }
+  if (move.is_capture() && move.kind() != Move::Kind::EN_PASSANT) {
+    hash ^= zobrist_randoms.coordinate_random(~ACTIVE_COLOR, move.captured(), move.target());
+    if (move.captured() == PieceType::ROOK) {
+      if (move.target() == OtherColorTraits::KINGSIDE_ROOK_INITIAL_ORIGIN) {
+        castling_rights &= ~OtherColorTraits::KINGSIDE_CASTLING_RIGHTS;
+      } else if (move.target() == OtherColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN) {
+        castling_rights &= ~OtherColorTraits::QUEENSIDE_CASTLING_RIGHTS;
+      }
+    }
+  }
+  if (castling_rights != castling_rights_) {
+    hash ^= zobrist_randoms.castling_rights_random(castling_rights_) ^
+            zobrist_randoms.castling_rights_random(castling_rights);
+  }
+  BOOST_ASSERT(hash == apply<ACTIVE_COLOR>(move).hash());
+  return hash;
+}
+
+template <Color ACTIVE_COLOR>
+void Position::make(const Move move, Undo& undo) {
+  BOOST_ASSERT(ACTIVE_COLOR == active_color_);
+  BOOST_ASSERT(move == annotate<ACTIVE_COLOR>(Move(move.origin(), move.target(), move.promotion())));
+  using ActiveColorTraits = ColorTraits<ACTIVE_COLOR>;
+  const auto& zobrist_randoms = zobrist::Randoms::instance();
+  undo = {.castling_rights = castling_rights_,
+          .en_passant_target = en_passant_target_,
+          .halfmove_clock = halfmove_clock_,
+          .hash = hash_,
+          .pawn_hash = pawn_hash_,
+          .material_key = material_key_};
+  hash_ ^= zobrist_randoms.active_color_random();
+  if (en_passant_target_ != NO_EN_PASSANT_TARGET) {
+    hash_ ^= zobrist_randoms.en_passant_file_random(file_of(en_passant_target_));
+    en_passant_target_ = NO_EN_PASSANT_TARGET;
+  }
+  ++halfmove_clock_;
   const Bitboard origin_mask(move.origin());
   const Bitboard target_mask(move.target());
   const auto toggle_piece = [&]<Color COLOR, PieceType PIECE_TYPE>(const Bitboard mask, const Coordinate coordinate) {
-    board.get<COLOR, PIECE_TYPE>() ^= mask;
-    hash ^= zobrist_randoms.coordinate_random<COLOR, PIECE_TYPE>(coordinate);
+    board_.get<COLOR, PIECE_TYPE>() ^= mask;
+    color_to_occupancy_[COLOR] ^= mask;
+    const auto random = zobrist_randoms.coordinate_random<COLOR, PIECE_TYPE>(coordinate);
+    hash_ ^= random;
+    if constexpr (PIECE_TYPE == PieceType::PAWN) {
+      pawn_hash_ ^= random;
+    }
   };
   const auto non_pawn_move = [&]<PieceType PIECE_TYPE> {
     toggle_piece.template operator()<ACTIVE_COLOR, PIECE_TYPE>(origin_mask, move.origin());
     toggle_piece.template operator()<ACTIVE_COLOR, PIECE_TYPE>(target_mask, move.target());
   };
   const auto revoke_castling_rights = [&]<CastlingRights CASTLING_RIGHTS> {
-    hash ^= zobrist_randoms.castling_rights_random(castling_rights);
-    castling_rights &= ~CASTLING_RIGHTS;
-    hash ^= zobrist_randoms.castling_rights_random(castling_rights);
+    hash_ ^= zobrist_randoms.castling_rights_random(castling_rights_);
+    castling_rights_ &= ~CASTLING_RIGHTS;
+    hash_ ^= zobrist_randoms.castling_rights_random(castling_rights_);
   };
-  const auto origin_piece_type = piece_type_at<ACTIVE_COLOR>(origin_mask);
-  BOOST_ASSERT(origin_piece_type.has_value());
-  switch (*origin_piece_type) {
+  mailbox_[move.origin()] = Piece();
+  mailbox_[move.target()] = Piece(ACTIVE_COLOR, move.promotion().value_or(move.piece_type()));
+  switch (move.piece_type()) {
     case PieceType::PAWN:
-      halfmove_clock = 0;
+      halfmove_clock_ = 0;
       toggle_piece.template operator()<ACTIVE_COLOR, PieceType::PAWN>(origin_mask, move.origin());
       if (const auto promotion = move.promotion(); promotion.has_value()) {
+        material_key_ += material_key_of(ACTIVE_COLOR, *promotion) - material_key_of(ACTIVE_COLOR, PieceType::PAWN);
         switch (*promotion) {
 #define _(PIECE_TYPE)                                                                                  \
   case PieceType::PIECE_TYPE:                                                                          \
@@ -268,15 +463,14 @@ Position Position::apply(const Move move) const {
         break;
       }
       toggle_piece.template operator()<ACTIVE_COLOR, PieceType::PAWN>(target_mask, move.target());
-      if (rank_of(move.origin()) == ActiveColorTraits::PAWN_INITIAL_RANK) {
-        if (rank_of(move.target()) == ActiveColorTraits::PAWN_DOUBLE_PUSH_TARGET_RANK) {
-          const auto file = file_of(move.target());
-          en_passant_target = to_coordinate(file, ActiveColorTraits::EN_PASSANT_TARGET_RANK);
-          hash ^= zobrist_randoms.en_passant_file_random(file);
-        }
-      } else if (en_passant_target_ == move.target()) {
-        const auto coordinate = unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(*en_passant_target_);
+      if (move.kind() == Move::Kind::DOUBLE_PUSH) {
+        const auto file = file_of(move.target());
+        en_passant_target_ = to_coordinate(file, ActiveColorTraits::EN_PASSANT_TARGET_RANK);
+        hash_ ^= zobrist_randoms.en_passant_file_random(file);
+      } else if (move.kind() == Move::Kind::EN_PASSANT) {
+        const auto coordinate = unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(move.target());
         toggle_piece.template operator()<~ACTIVE_COLOR, PieceType::PAWN>(Bitboard(coordinate), coordinate);
+        mailbox_[coordinate] = Piece();
       }
       break;
     case PieceType::ROOK:
@@ -287,25 +481,26 @@ Position Position::apply(const Move move) const {
         revoke_castling_rights.template operator()<ActiveColorTraits::QUEENSIDE_CASTLING_RIGHTS>();
       }
       break;
-    case PieceType::KING: {
+    case PieceType::KING:
       non_pawn_move.template operator()<PieceType::KING>();
-      const auto move_rook = [&]<Coordinate ORIGIN, Coordinate TARGET> {
-        toggle_piece.template operator()<ACTIVE_COLOR, PieceType::ROOK>(Bitboard(ORIGIN), ORIGIN);
-        toggle_piece.template operator()<ACTIVE_COLOR, PieceType::ROOK>(Bitboard(TARGET), TARGET);
-      };
-      if ((castling_rights & ActiveColorTraits::KINGSIDE_CASTLING_RIGHTS) != CastlingRights::NONE &&
-          move.target() == ActiveColorTraits::KING_KINGSIDE_CASTLE_TARGET) {
-        move_rook.template
-        operator()<ActiveColorTraits::KINGSIDE_ROOK_INITIAL_ORIGIN, ActiveColorTraits::KINGSIDE_ROOK_CASTLE_TARGET>();
-      } else if ((castling_rights & ActiveColorTraits::QUEENSIDE_CASTLING_RIGHTS) != CastlingRights::NONE &&
-                 move.target() == ActiveColorTraits::KING_QUEENSIDE_CASTLE_TARGET) {
-        move_rook.template
-        operator()<ActiveColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN, ActiveColorTraits::QUEENSIDE_ROOK_CASTLE_TARGET>();
+      if (move.kind() == Move::Kind::CASTLE) {
+        const auto move_rook = [&]<Coordinate ORIGIN, Coordinate TARGET> {
+          toggle_piece.template operator()<ACTIVE_COLOR, PieceType::ROOK>(Bitboard(ORIGIN), ORIGIN);
+          toggle_piece.template operator()<ACTIVE_COLOR, PieceType::ROOK>(Bitboard(TARGET), TARGET);
+          mailbox_[ORIGIN] = Piece();
+          mailbox_[TARGET] = Piece(ACTIVE_COLOR, PieceType::ROOK);
+        };
+        if (move.target() == ActiveColorTraits::KING_KINGSIDE_CASTLE_TARGET) {
+          move_rook.template
+          operator()<ActiveColorTraits::KINGSIDE_ROOK_INITIAL_ORIGIN, ActiveColorTraits::KINGSIDE_ROOK_CASTLE_TARGET>();
+        } else {
+          move_rook.template operator()<ActiveColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN,
+                                        ActiveColorTraits::QUEENSIDE_ROOK_CASTLE_TARGET>();
+        }
       }
       revoke_castling_rights.template
       operator()<ActiveColorTraits::KINGSIDE_CASTLING_RIGHTS | ActiveColorTraits::QUEENSIDE_CASTLING_RIGHTS>();
       break;
-    }
 #define _(PIECE_TYPE)                                           \
   case PieceType::PIECE_TYPE:                                   \
     non_pawn_move.template operator()<PieceType::PIECE_TYPE>(); \
@@ -315,9 +510,12 @@ Position Position::apply(const Move move) const {
       _(QUEEN);
 #undef _
   }
-  if (const auto target_piece_type = piece_type_at<~ACTIVE_COLOR>(target_mask); target_piece_type.has_value()) {
-    halfmove_clock = 0;
-    switch (*target_piece_type) {
+  if (move.is_capture()) {
+    material_key_ -= material_key_of(~ACTIVE_COLOR, move.captured());
+  }
+  if (move.is_capture() && move.kind() != Move::Kind::EN_PASSANT) {
+    halfmove_clock_ = 0;
+    switch (move.captured()) {
       case PieceType::ROOK: {
         toggle_piece.template operator()<~ACTIVE_COLOR, PieceType::ROOK>(target_mask, move.target());
         using OtherColorTraits = ColorTraits<~ACTIVE_COLOR>;
@@ -341,13 +539,134 @@ Position Position::apply(const Move move) const {
         __builtin_unreachable();
     }
   }
-  BOOST_ASSERT(hash == Position(board, ~ACTIVE_COLOR, castling_rights, en_passant_target, halfmove_clock,
-                                fullmove_number_ + (ACTIVE_COLOR == Color::BLACK))
-                           .hash());
-  return Position(board, ~ACTIVE_COLOR, castling_rights, en_passant_target, halfmove_clock,
-                  fullmove_number_ + (ACTIVE_COLOR == Color::BLACK), hash);
+  active_color_ = ~ACTIVE_COLOR;
+  fullmove_number_ += ACTIVE_COLOR == Color::BLACK;
+  BOOST_ASSERT([&] {
+    const Position position(board_, active_color_, castling_rights_, en_passant_target(), halfmove_clock_,
+                            fullmove_number_);
+    return hash_ == position.hash_ && pawn_hash_ == position.pawn_hash_ && material_key_ == position.material_key_ &&
+           color_to_occupancy_ == position.color_to_occupancy_ && mailbox_ == position.mailbox_;
+  }());
+}
+
+template <Color ACTIVE_COLOR>
+void Position::unmake(const Move move, const Undo& undo) {
+  BOOST_ASSERT(ACTIVE_COLOR == ~active_color_);
+  using ActiveColorTraits = ColorTraits<ACTIVE_COLOR>;
+  const auto toggle_piece = [&]<Color COLOR, PieceType PIECE_TYPE>(const Coordinate coordinate) {
+    board_.get<COLOR, PIECE_TYPE>() ^= Bitboard(coordinate);
+    color_to_occupancy_[COLOR] ^= Bitboard(coordinate);
+  };
+  const auto toggle_active_piece = [&](const PieceType piece_type, const Coordinate coordinate) {
+    switch (piece_type) {
+#define _(PIECE_TYPE)                                                                  \
+  case PieceType::PIECE_TYPE:                                                          \
+    toggle_piece.template operator()<ACTIVE_COLOR, PieceType::PIECE_TYPE>(coordinate); \
+    break
+      _(PAWN);
+      _(KNIGHT);
+      _(BISHOP);
+      _(ROOK);
+      _(QUEEN);
+      _(KING);
+#undef _
+    }
+  };
+  toggle_active_piece(move.piece_type(), move.origin());
+  toggle_active_piece(move.promotion().value_or(move.piece_type()), move.target());
+  mailbox_[move.origin()] = Piece(ACTIVE_COLOR, move.piece_type());
+  mailbox_[move.target()] = Piece();
+  if (move.kind() == Move::Kind::EN_PASSANT) {
+    const auto coordinate = unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(move.target());
+    toggle_piece.template operator()<~ACTIVE_COLOR, PieceType::PAWN>(coordinate);
+    mailbox_[coordinate] = Piece(~ACTIVE_COLOR, PieceType::PAWN);
+  } else if (move.is_capture()) {
+    switch (move.captured()) {
+#define _(PIECE_TYPE)                                                                      \
+  case PieceType::PIECE_TYPE:                                                              \
+    toggle_piece.template operator()<~ACTIVE_COLOR, PieceType::PIECE_TYPE>(move.target()); \
+    break
+      _(PAWN);
+      _(KNIGHT);
+      _(BISHOP);
+      _(ROOK);
+      _(QUEEN);
+#undef _
+      case PieceType::KING:
+        BOOST_ASSERT(false);
+        __builtin_unreachable();
+    }
+    mailbox_[move.target()] = Piece(~ACTIVE_COLOR, move.captured());
+  } else if (move.kind() == Move::Kind::CASTLE) {
+    const auto move_rook_back = [&]<Coordinate ORIGIN, Coordinate TARGET> {
+      toggle_piece.template operator()<ACTIVE_COLOR, PieceType::ROOK>(ORIGIN);
+      toggle_piece.template operator()<ACTIVE_COLOR, PieceType::ROOK>(TARGET);
+      mailbox_[ORIGIN] = Piece(ACTIVE_COLOR, PieceType::ROOK);
+      mailbox_[TARGET] = Piece();
+    };
+    if (move.target() == ActiveColorTraits::KING_KINGSIDE_CASTLE_TARGET) {
+      move_rook_back.template
+      operator()<ActiveColorTraits::KINGSIDE_ROOK_INITIAL_ORIGIN, ActiveColorTraits::KINGSIDE_ROOK_CASTLE_TARGET>();
+    } else {
+      move_rook_back.template
+      operator()<ActiveColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN, ActiveColorTraits::QUEENSIDE_ROOK_CASTLE_TARGET>();
+    }
+  }
+  active_color_ = ACTIVE_COLOR;
+  castling_rights_ = undo.castling_rights;
+  en_passant_target_ = undo.en_passant_target;
+  halfmove_clock_ = undo.halfmove_clock;
+  fullmove_number_ -= ACTIVE_COLOR == Color::BLACK;
+  hash_ = undo.hash;
+  pawn_hash_ = undo.pawn_hash;
+  material_key_ = undo.material_key;
+}
+
+template <Color ACTIVE_COLOR>
+Position Position::apply(const Move move) const {
+  auto position = *this;
+  Undo undo;
+  position.make<ACTIVE_COLOR>(move, undo);
+  return position;
+}
+
+template <Color ACTIVE_COLOR>
+Move Position::annotate(const Move move) const {
+  using ActiveColorTraits = ColorTraits<ACTIVE_COLOR>;
+  const auto piece_type = piece_type_at<ACTIVE_COLOR>(move.origin());
+  BOOST_ASSERT(piece_type.has_value());
+  auto kind = Move::Kind::NORMAL;
+  if (*piece_type == PieceType::PAWN) {
+    if (rank_of(move.origin()) == ActiveColorTraits::PAWN_INITIAL_RANK &&
+        rank_of(move.target()) == ActiveColorTraits::PAWN_DOUBLE_PUSH_TARGET_RANK) {
+      kind = Move::Kind::DOUBLE_PUSH;
+    } else if (move.target() == en_passant_target()) {
+      kind = Move::Kind::EN_PASSANT;
+    }
+  } else if (*piece_type == PieceType::KING && move.origin() == ActiveColorTraits::KING_INITIAL_ORIGIN &&
+             (move.target() == ActiveColorTraits::KING_KINGSIDE_CASTLE_TARGET ||
+              move.target() == ActiveColorTraits::KING_QUEENSIDE_CASTLE_TARGET)) {
+    kind = Move::Kind::CASTLE;
+  }
+  auto annotated_move = Move(*piece_type, move.origin(), move.target(), kind);
+  if (kind == Move::Kind::EN_PASSANT) {
+    annotated_move = annotated_move.with_capture(PieceType::PAWN);
+  } else if (const auto captured = piece_type_at<~ACTIVE_COLOR>(move.target()); captured.has_value()) {
+    annotated_move = annotated_move.with_capture(*captured);
+  }
+  if (const auto promotion = move.promotion(); promotion.has_value()) {
+    annotated_move = annotated_move.with_promotion(*promotion);
+  }
+  return annotated_move;
 }
 
-template Position Position::apply<Color::WHITE>(Move) const;
-template Position Position::apply<Color::BLACK>(Move) const;
+#define _(ACTIVE_COLOR)                                                        \
+  template void Position::make<Color::ACTIVE_COLOR>(Move, Undo&);              \
+  template void Position::unmake<Color::ACTIVE_COLOR>(Move, const Undo&);      \
+  template Position Position::apply<Color::ACTIVE_COLOR>(Move) const;          \
+  template Move Position::annotate<Color::ACTIVE_COLOR>(Move) const;           \
+  template zobrist::Hash Position::hash_after<Color::ACTIVE_COLOR>(Move) const
+_(WHITE);
+_(BLACK);
+#undef _
 }
@@ -6,29 +6,42 @@
 #include <string>
 #include <string_view>
 
+#include "base/cache_line_size.h"
 #include "base/ply.h"
 #include "board/bitboard.h"
 #include "board/board.h"
 #include "board/castling_rights.h"
 #include "board/color.h"
+#include "board/color_map.h"
 #include "board/coordinate.h"
+#include "board/coordinate_map.h"
+#include "board/material_key.h"
 #include "board/move.h"
+#include "board/piece.h"
 #include "board/piece_type.h"
+#include "board/undo.h"
 #include "zobrist/hash.h"
 
 namespace prodigy::board {
-class Position final {
+class alignas(CACHE_LINE_SIZE) Position final {
  public:
   static Position from_fen(std::string_view);
 
+  // Whether from_fen can parse the FEN into a position that the move generator can handle, so that FENs from outside of
+  // the program can be checked before anything asserts on them. Such a position has one king of each color, at most
+  // eight pawns and sixteen pieces a side, no pawns on the back ranks, and an en passant target only behind a pawn that
+  // could just have moved two squares past it.
+  static bool is_valid_fen(std::string_view);
+
   static const Position& starting_position();
 
   template <Color COLOR>
   constexpr Bitboard all_pieces() const {
-    return pieces<COLOR, PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN,
-                  PieceType::KING>();
+    return color_to_occupancy_[COLOR];
   }
 
+  constexpr Bitboard occupancy() const { return color_to_occupancy_[Color::WHITE] | color_to_occupancy_[Color::BLACK]; }
+
   template <Color COLOR, PieceType... PIECE_TYPES>
   constexpr Bitboard pieces() const {
     return (board_.get<COLOR, PIECE_TYPES>() | ...);
@@ -38,7 +51,9 @@ class Position final {
 
   constexpr CastlingRights castling_rights() const { return castling_rights_; }
 
-  constexpr std::optional<Coordinate> en_passant_target() const { return en_passant_target_; }
+  constexpr std::optional<Coordinate> en_passant_target() const {
+    return en_passant_target_ == NO_EN_PASSANT_TARGET ? std::nullopt : std::optional(en_passant_target_);
+  }
 
   constexpr Ply halfmove_clock() const { return halfmove_clock_; }
 
@@ -46,63 +61,84 @@ class Position final {
 
   constexpr zobrist::Hash hash() const { return hash_; }
 
+  // Hashes only the pawns, for tables keyed by pawn structure.
+  constexpr zobrist::Hash pawn_hash() const { return pawn_hash_; }
+
+  constexpr MaterialKey material_key() const { return material_key_; }
+
   std::string fen() const;
 
+  // Takes a move annotated by the move generator or by annotate.
   template <Color ACTIVE_COLOR>
   [[nodiscard]] Position apply(Move) const;
 
+  // The hash of the position that applying the move leads to, without building that position, so that the transposition
+  // table can be prefetched before the move is made.
+  template <Color ACTIVE_COLOR>
+  zobrist::Hash hash_after(Move) const;
+
+  // Applies the move in place, saving what unmake needs to take it back.
+  template <Color ACTIVE_COLOR>
+  void make(Move, Undo&);
+
+  // Takes back the last move made, which ACTIVE_COLOR made.
+  template <Color ACTIVE_COLOR>
+  void unmake(Move, const Undo&);
+
+  // Fills in what a move that only has its origin, target and promotion does in this position. Looks up the pieces it
+  // moves and captures, so it is meant for moves from outside of search, such as UCI.
+  template <Color ACTIVE_COLOR>
+  Move annotate(Move) const;
+
+  constexpr Piece piece_at(const Coordinate coordinate) const { return mailbox_[coordinate]; }
+
   template <Color COLOR>
   constexpr std::optional<PieceType> piece_type_at(const Coordinate coordinate) const {
-    return piece_type_at<COLOR>(Bitboard(coordinate));
+    const auto piece = piece_at(coordinate);
+    return piece && piece.color() == COLOR ? std::optional(piece.piece_type()) : std::nullopt;
   }
 
  private:
-  constexpr Position(const Board& board, const Color active_color, const CastlingRights castling_rights,
-                     const std::optional<Coordinate> en_passant_target, const Ply halfmove_clock,
-                     const std::uint16_t fullmove_number, const zobrist::Hash hash)
+  // En passant targets are never on the first rank.
+  static constexpr auto NO_EN_PASSANT_TARGET = Coordinate::A1;
+
+  constexpr Position(const Board& board, const ColorMap<Bitboard>& color_to_occupancy,
+                     const CoordinateMap<Piece>& mailbox, const Color active_color,
+                     const CastlingRights castling_rights, const std::optional<Coordinate> en_passant_target,
+                     const Ply halfmove_clock, const std::uint16_t fullmove_number, const zobrist::Hash hash,
+                     const zobrist::Hash pawn_hash, const MaterialKey material_key)
       : board_(board),
+        color_to_occupancy_(color_to_occupancy),
+        mailbox_(mailbox),
+        hash_(hash),
+        pawn_hash_(pawn_hash),
+        material_key_(material_key),
         active_color_(active_color),
         castling_rights_(castling_rights),
-        en_passant_target_(en_passant_target),
+        en_passant_target_(en_passant_target.value_or(NO_EN_PASSANT_TARGET)),
         halfmove_clock_(halfmove_clock),
-        fullmove_number_(fullmove_number),
-        hash_(hash) {}
+        fullmove_number_(fullmove_number) {}
 
   Position(const Board&, Color active_color, CastlingRights, std::optional<Coordinate> en_passant_target,
            Ply halfmove_clock, std::uint16_t fullmove_number);
 
-  // TODO: consider an auxillary CoordinateMap member variable which will allow this to only require a single lookup.
-  template <Color COLOR>
-  constexpr std::optional<PieceType> piece_type_at(const Bitboard mask) const {
-    if (board_.get<COLOR, PieceType::PAWN>() & mask) {
-      return PieceType::PAWN;
-    }
-    if (board_.get<COLOR, PieceType::KNIGHT>() & mask) {
-      return PieceType::KNIGHT;
-    }
-    if (board_.get<COLOR, PieceType::BISHOP>() & mask) {
-      return PieceType::BISHOP;
-    }
-    if (board_.get<COLOR, PieceType::ROOK>() & mask) {
-      return PieceType::ROOK;
-    }
-    if (board_.get<COLOR, PieceType::QUEEN>() & mask) {
-      return PieceType::QUEEN;
-    }
-    if (board_.get<COLOR, PieceType::KING>() & mask) {
-      return PieceType::KING;
-    }
-    return std::nullopt;
-  }
-
+  // The occupancy of each color, the mailbox, the pawn hash and the material key mirror board_. The total occupancy is
+  // left out, since it is a single OR of the color occupancies, and keeping it in step would cost a store every move.
   Board board_;
+  ColorMap<Bitboard> color_to_occupancy_;
+  CoordinateMap<Piece> mailbox_;
+  zobrist::Hash hash_;
+  zobrist::Hash pawn_hash_;
+  MaterialKey material_key_;
   Color active_color_;
   CastlingRights castling_rights_;
-  std::optional<Coordinate> en_passant_target_;
+  Coordinate en_passant_target_;
   Ply halfmove_clock_;
   std::uint16_t fullmove_number_;
-  zobrist::Hash hash_;
 };
 
+// Copy-make copies whole positions, so the size is kept to four cache lines.
+static_assert(sizeof(Position) == 4 * CACHE_LINE_SIZE);
+
 std::ostream& operator<<(std::ostream&, const Position&);
 }
@@ -9,6 +9,8 @@
 #include <type_traits>
 
 #include "board/coordinate.h"
+#include "board/direction.h"
+#include "board/rank.h"
 
 namespace prodigy::board {
 namespace {
@@ -20,6 +22,12 @@ static_assert(Bitboard(Coordinate::E1).popcount() == 1);
 static_assert((Bitboard(Coordinate::E2) | Bitboard(Coordinate::E3)).popcount() == 2);
 static_assert((~Bitboard()).popcount() == 64);
 
+static_assert(Bitboard(Rank::ONE) == (Bitboard(Coordinate::A1) | Bitboard(Coordinate::B1) | Bitboard(Coordinate::C1) |
+                                      Bitboard(Coordinate::D1) | Bitboard(Coordinate::E1) | Bitboard(Coordinate::F1) |
+                                      Bitboard(Coordinate::G1) | Bitboard(Coordinate::H1)));
+static_assert(Bitboard(Rank::EIGHT).popcount() == 8);
+static_assert(Bitboard(Coordinate::H8) & Bitboard(Rank::EIGHT));
+
 BOOST_AUTO_TEST_CASE(lsb) {
   for_each_coordinate([bitboard = ~Bitboard()](const auto coordinate) mutable {
     BOOST_TEST(bitboard.lsb() == Bitboard(coordinate));
@@ -27,6 +35,23 @@ BOOST_AUTO_TEST_CASE(lsb) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(shift) {
+  for_each_coordinate([](const auto coordinate) {
+    const auto expect_shift = [&]<Direction DIRECTION> {
+      const auto target = directional_offset<DIRECTION>(coordinate);
+      BOOST_TEST((Bitboard(coordinate).shift<DIRECTION>() == (target.has_value() ? Bitboard(*target) : Bitboard())));
+    };
+    expect_shift.template operator()<Direction::NORTH>();
+    expect_shift.template operator()<Direction::EAST>();
+    expect_shift.template operator()<Direction::SOUTH>();
+    expect_shift.template operator()<Direction::WEST>();
+    expect_shift.template operator()<Direction::NORTH_EAST>();
+    expect_shift.template operator()<Direction::SOUTH_EAST>();
+    expect_shift.template operator()<Direction::SOUTH_WEST>();
+    expect_shift.template operator()<Direction::NORTH_WEST>();
+  });
+}
+
 BOOST_AUTO_TEST_CASE(test_unsafe_to_coordinate) {
   for_each_coordinate(
       [](const auto coordinate) { BOOST_TEST(unsafe_to_coordinate(Bitboard(coordinate)) == coordinate); });
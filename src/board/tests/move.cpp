@@ -25,8 +25,9 @@ std::ostream& boost_test_print_type(std::ostream& os, const std::optional<PieceT
 }
 
 namespace {
-static_assert(sizeof(Move) == 2);
+static_assert(sizeof(Move) == 4);
 static_assert(std::is_trivially_copyable_v<Move>);
+static_assert(std::is_trivially_default_constructible_v<Move>);
 
 constexpr Move MOVE(Coordinate::C1, Coordinate::C2);
 static_assert(MOVE.origin() == Coordinate::C1);
@@ -53,6 +54,32 @@ static_assert(QUEEN_PROMOTION.origin() == Coordinate::D7);
 static_assert(QUEEN_PROMOTION.target() == Coordinate::D8);
 static_assert(QUEEN_PROMOTION.promotion() == PieceType::QUEEN);
 
+constexpr auto EN_PASSANT = Move(PieceType::PAWN, Coordinate::E5, Coordinate::D6, Move::Kind::EN_PASSANT)
+                                .with_capture(PieceType::PAWN);
+static_assert(EN_PASSANT.origin() == Coordinate::E5);
+static_assert(EN_PASSANT.target() == Coordinate::D6);
+static_assert(EN_PASSANT.piece_type() == PieceType::PAWN);
+static_assert(EN_PASSANT.is_capture());
+static_assert(EN_PASSANT.captured() == PieceType::PAWN);
+static_assert(EN_PASSANT.kind() == Move::Kind::EN_PASSANT);
+
+constexpr auto CAPTURING_PROMOTION = Move(PieceType::PAWN, Coordinate::G7, Coordinate::H8)
+                                         .with_capture(PieceType::ROOK)
+                                         .with_promotion(PieceType::KNIGHT);
+static_assert(CAPTURING_PROMOTION.piece_type() == PieceType::PAWN);
+static_assert(CAPTURING_PROMOTION.captured() == PieceType::ROOK);
+static_assert(CAPTURING_PROMOTION.promotion() == PieceType::KNIGHT);
+static_assert(CAPTURING_PROMOTION.kind() == Move::Kind::NORMAL);
+
+constexpr Move CASTLE(PieceType::KING, Coordinate::E8, Coordinate::C8, Move::Kind::CASTLE);
+static_assert(CASTLE.piece_type() == PieceType::KING);
+static_assert(!CASTLE.is_capture());
+static_assert(!CASTLE.promotion().has_value());
+static_assert(CASTLE.kind() == Move::Kind::CASTLE);
+static_assert(Move::from_compact(CASTLE.compact()) == Move(Coordinate::E8, Coordinate::C8));
+static_assert(Move::from_compact(CAPTURING_PROMOTION.compact()) ==
+              Move(Coordinate::G7, Coordinate::H8, PieceType::KNIGHT));
+
 BOOST_AUTO_TEST_CASE(test_move_constructor) {
   for_each_coordinate([](const auto origin) {
     for_each_coordinate([&](const auto target) {
@@ -0,0 +1,33 @@
+#define BOOST_TEST_MODULE Piece
+
+#include "board/piece.h"
+
+#include <boost/test/tools/output_test_stream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "board/color.h"
+#include "board/piece_type.h"
+
+namespace prodigy::board {
+namespace {
+static_assert(sizeof(Piece) == 1);
+
+static_assert(!Piece());
+static_assert(Piece(Color::WHITE, PieceType::PAWN));
+static_assert(Piece(Color::BLACK, PieceType::QUEEN).color() == Color::BLACK);
+static_assert(Piece(Color::BLACK, PieceType::QUEEN).piece_type() == PieceType::QUEEN);
+static_assert(Piece(Color::WHITE, PieceType::KING) != Piece(Color::BLACK, PieceType::KING));
+
+BOOST_AUTO_TEST_CASE(output_stream) {
+  boost::test_tools::output_test_stream os;
+  os << Piece(Color::WHITE, PieceType::PAWN);
+  BOOST_TEST(os.is_equal("P"));
+  os << Piece(Color::WHITE, PieceType::KING);
+  BOOST_TEST(os.is_equal("K"));
+  os << Piece(Color::BLACK, PieceType::KNIGHT);
+  BOOST_TEST(os.is_equal("n"));
+  os << Piece(Color::BLACK, PieceType::ROOK);
+  BOOST_TEST(os.is_equal("r"));
+}
+}
+}
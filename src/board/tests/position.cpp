@@ -4,21 +4,25 @@
 
 #include <boost/test/unit_test.hpp>
 #include <cstdint>
+#include <initializer_list>
 #include <optional>
 #include <ostream>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
 
+#include "base/cache_line_size.h"
 #include "base/ply.h"
 #include "board/bitboard.h"
 #include "board/castling_rights.h"
 #include "board/color.h"
 #include "board/coordinate.h"
+#include "board/material_key.h"
 #include "board/move.h"
 #include "board/piece_type.h"
 #include "board/rank.h"
 #include "board/starting_position_fen.h"
+#include "board/undo.h"
 
 namespace prodigy::board {
 template <typename T>
@@ -33,12 +37,23 @@ std::ostream& boost_test_print_type(std::ostream& os, const std::optional<T>& op
 
 namespace {
 static_assert(std::is_trivially_copyable_v<Position>);
+static_assert(sizeof(Position) == 4 * CACHE_LINE_SIZE);
+
+Position apply(Position position, const std::initializer_list<Move> moves) {
+  for (const auto move : moves) {
+    position = position.active_color() == Color::WHITE
+                   ? position.apply<Color::WHITE>(position.annotate<Color::WHITE>(move))
+                   : position.apply<Color::BLACK>(position.annotate<Color::BLACK>(move));
+  }
+  return position;
+}
 
 Position test_move(const Position& position_before_move, const Move move, const CastlingRights expected_castling_rights,
                    const std::optional<Coordinate> expected_en_passant_target = std::nullopt) {
   const auto apply_and_validate =
       [&]<Color ACTIVE_COLOR> {
-        const auto position_after_move = position_before_move.apply<ACTIVE_COLOR>(move);
+        const auto position_after_move =
+            position_before_move.apply<ACTIVE_COLOR>(position_before_move.annotate<ACTIVE_COLOR>(move));
         BOOST_TEST_CONTEXT("BEFORE MOVE:\n"
                                << position_before_move,
                            "AFTER MOVE:\n"
@@ -72,6 +87,22 @@ Position test_move(const Position& position_before_move, const Move move, const
             BOOST_TEST(position_after_move.fullmove_number() == position_before_move.fullmove_number() + 1);
           }
           BOOST_TEST(position_after_move.hash() == Position::from_fen(position_after_move.fen()).hash());
+          BOOST_TEST(position_after_move.pawn_hash() == Position::from_fen(position_after_move.fen()).pawn_hash());
+          BOOST_TEST(position_after_move.material_key() ==
+                     Position::from_fen(position_after_move.fen()).material_key());
+          BOOST_TEST(position_before_move.hash_after<ACTIVE_COLOR>(position_before_move.annotate<ACTIVE_COLOR>(move)) ==
+                     position_after_move.hash());
+
+          auto position = position_before_move;
+          Undo undo;
+          position.make<ACTIVE_COLOR>(position_before_move.annotate<ACTIVE_COLOR>(move), undo);
+          BOOST_TEST(position.fen() == position_after_move.fen());
+          BOOST_TEST(position.hash() == position_after_move.hash());
+          position.unmake<ACTIVE_COLOR>(position_before_move.annotate<ACTIVE_COLOR>(move), undo);
+          BOOST_TEST(position.fen() == position_before_move.fen());
+          BOOST_TEST(position.hash() == position_before_move.hash());
+          BOOST_TEST(position.pawn_hash() == position_before_move.pawn_hash());
+          BOOST_TEST(position.material_key() == position_before_move.material_key());
         }
         return position_after_move;
       };
@@ -325,38 +356,98 @@ BOOST_AUTO_TEST_CASE(fullmove_number) {
 }
 
 BOOST_AUTO_TEST_CASE(same_zobrist_hash_after_undo) {
-  BOOST_TEST(Position::starting_position()
-                 .apply<Color::WHITE>(Move(Coordinate::G1, Coordinate::F3))
-                 .apply<Color::BLACK>(Move(Coordinate::G8, Coordinate::F6))
-                 .apply<Color::WHITE>(Move(Coordinate::F3, Coordinate::G1))
-                 .apply<Color::BLACK>(Move(Coordinate::F6, Coordinate::G8))
+  BOOST_TEST(apply(Position::starting_position(),
+                   {Move(Coordinate::G1, Coordinate::F3), Move(Coordinate::G8, Coordinate::F6),
+                    Move(Coordinate::F3, Coordinate::G1), Move(Coordinate::F6, Coordinate::G8)})
                  .hash() == Position::starting_position().hash());
 }
 
 BOOST_AUTO_TEST_CASE(transposition_zobrist_hash) {
-  BOOST_TEST(Position::starting_position()
-                 .apply<Color::WHITE>(Move(Coordinate::E2, Coordinate::E3))
-                 .apply<Color::BLACK>(Move(Coordinate::E7, Coordinate::E6))
-                 .apply<Color::WHITE>(Move(Coordinate::G1, Coordinate::F3))
-                 .apply<Color::BLACK>(Move(Coordinate::G8, Coordinate::F6))
-                 .hash() == Position::starting_position()
-                                .apply<Color::WHITE>(Move(Coordinate::G1, Coordinate::F3))
-                                .apply<Color::BLACK>(Move(Coordinate::G8, Coordinate::F6))
-                                .apply<Color::WHITE>(Move(Coordinate::E2, Coordinate::E3))
-                                .apply<Color::BLACK>(Move(Coordinate::E7, Coordinate::E6))
-                                .hash());
-
-  BOOST_TEST(Position::starting_position()
-                 .apply<Color::WHITE>(Move(Coordinate::E2, Coordinate::E4))
-                 .apply<Color::BLACK>(Move(Coordinate::E7, Coordinate::E5))
-                 .apply<Color::WHITE>(Move(Coordinate::G1, Coordinate::F3))
-                 .apply<Color::BLACK>(Move(Coordinate::G8, Coordinate::F6))
-                 .hash() != Position::starting_position()
-                                .apply<Color::WHITE>(Move(Coordinate::G1, Coordinate::F3))
-                                .apply<Color::BLACK>(Move(Coordinate::G8, Coordinate::F6))
-                                .apply<Color::WHITE>(Move(Coordinate::E2, Coordinate::E4))
-                                .apply<Color::BLACK>(Move(Coordinate::E7, Coordinate::E5))
-                                .hash());
+  BOOST_TEST(apply(Position::starting_position(),
+                   {Move(Coordinate::E2, Coordinate::E3), Move(Coordinate::E7, Coordinate::E6),
+                    Move(Coordinate::G1, Coordinate::F3), Move(Coordinate::G8, Coordinate::F6)})
+                 .hash() ==
+             apply(Position::starting_position(),
+                   {Move(Coordinate::G1, Coordinate::F3), Move(Coordinate::G8, Coordinate::F6),
+                    Move(Coordinate::E2, Coordinate::E3), Move(Coordinate::E7, Coordinate::E6)})
+                 .hash());
+
+  BOOST_TEST(apply(Position::starting_position(),
+                   {Move(Coordinate::E2, Coordinate::E4), Move(Coordinate::E7, Coordinate::E5),
+                    Move(Coordinate::G1, Coordinate::F3), Move(Coordinate::G8, Coordinate::F6)})
+                 .hash() !=
+             apply(Position::starting_position(),
+                   {Move(Coordinate::G1, Coordinate::F3), Move(Coordinate::G8, Coordinate::F6),
+                    Move(Coordinate::E2, Coordinate::E4), Move(Coordinate::E7, Coordinate::E5)})
+                 .hash());
+}
+
+// The keys are fixed at compile time, so these hold in every process on every machine.
+BOOST_AUTO_TEST_CASE(stable_zobrist_hash) {
+  BOOST_TEST(Position::starting_position().hash() == 17'965'690'467'908'649'876U);
+  BOOST_TEST(Position::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1").hash() ==
+             15'083'779'882'686'129'622U);
+  BOOST_TEST(Position::from_fen("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3").hash() ==
+             15'805'036'139'908'729'957U);
+}
+BOOST_AUTO_TEST_CASE(is_valid_fen) {
+  BOOST_TEST(Position::is_valid_fen(STARTING_POSITION_FEN));
+  BOOST_TEST(Position::is_valid_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+  BOOST_TEST(Position::is_valid_fen("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"));
+  BOOST_TEST(Position::is_valid_fen("4k3/8/8/8/8/8/8/4K3 b - - 99 120"));
+
+  BOOST_TEST(!Position::is_valid_fen(""));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBN w KQkq - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNRR w KQkq - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqqbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQ - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KKkq - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 256 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 x"));
+  BOOST_TEST(!Position::is_valid_fen("4k3/8/8/8/8/P7/PPPPPPPP/4K3 w - - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("4k3/8/8/8/QQQQQQQQ/QQQQQQQQ/8/4K3 w - - 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("4k2P/8/8/8/8/8/8/4K3 w - - 0 1"));
+  BOOST_TEST(Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"));
+  BOOST_TEST(!Position::is_valid_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq e3 0 1"));
+}
+
+BOOST_AUTO_TEST_CASE(pawn_hash) {
+  const auto& starting_position = Position::starting_position();
+  BOOST_TEST(apply(starting_position, {Move(Coordinate::G1, Coordinate::F3), Move(Coordinate::B8, Coordinate::C6)})
+                 .pawn_hash() == starting_position.pawn_hash());
+  BOOST_TEST(apply(starting_position, {Move(Coordinate::E2, Coordinate::E4)}).pawn_hash() !=
+             starting_position.pawn_hash());
+  BOOST_TEST(apply(starting_position, {Move(Coordinate::E2, Coordinate::E4)}).pawn_hash() ==
+             apply(starting_position, {Move(Coordinate::E2, Coordinate::E3), Move(Coordinate::G8, Coordinate::F6),
+                                       Move(Coordinate::E3, Coordinate::E4)})
+                 .pawn_hash());
+  BOOST_TEST(Position::from_fen("4k3/8/8/8/8/8/8/4K3 w - - 0 1").pawn_hash() == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(material_key) {
+  const auto material_key = Position::starting_position().material_key();
+  for (const auto color : {Color::WHITE, Color::BLACK}) {
+    BOOST_TEST(piece_count(material_key, color, PieceType::PAWN) == 8U);
+    BOOST_TEST(piece_count(material_key, color, PieceType::KNIGHT) == 2U);
+    BOOST_TEST(piece_count(material_key, color, PieceType::BISHOP) == 2U);
+    BOOST_TEST(piece_count(material_key, color, PieceType::ROOK) == 2U);
+    BOOST_TEST(piece_count(material_key, color, PieceType::QUEEN) == 1U);
+    BOOST_TEST(piece_count(material_key, color, PieceType::KING) == 1U);
+  }
+
+  const auto position_after_capture_promotion =
+      test_move("1n2k3/P7/8/8/8/8/8/4K3 w - - 0 1", Move(Coordinate::A7, Coordinate::B8, PieceType::QUEEN),
+                CastlingRights::NONE);
+  BOOST_TEST(position_after_capture_promotion.material_key() ==
+             material_key_of(Color::WHITE, PieceType::QUEEN) + material_key_of(Color::WHITE, PieceType::KING) +
+                 material_key_of(Color::BLACK, PieceType::KING));
+  BOOST_TEST(position_after_capture_promotion.material_key() ==
+             Position::from_fen("1Q2k3/8/8/8/8/8/8/4K3 b - - 0 1").material_key());
 }
 }
 }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "base/ply.h"
+#include "board/castling_rights.h"
+#include "board/coordinate.h"
+#include "board/material_key.h"
+#include "zobrist/hash.h"
+
+namespace prodigy::board {
+// The state that Position::make overwrites and Position::unmake cannot recompute from the move. What the move captured
+// is already part of the move.
+struct Undo final {
+  CastlingRights castling_rights;
+  // As stored by Position, which has a sentinel for no en passant target.
+  Coordinate en_passant_target;
+  Ply halfmove_clock;
+  zobrist::Hash hash;
+  zobrist::Hash pawn_hash;
+  MaterialKey material_key;
+};
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "board/piece_type.h"
+#include "eval/score.h"
+
+namespace prodigy::eval {
+// In centipawns. The king is never captured, so it has no value.
+constexpr Score piece_value(const board::PieceType piece_type) {
+  switch (piece_type) {
+    case board::PieceType::PAWN:
+      return 100;
+    case board::PieceType::KNIGHT:
+      return 300;
+    case board::PieceType::BISHOP:
+      return 300;
+    case board::PieceType::ROOK:
+      return 500;
+    case board::PieceType::QUEEN:
+      return 900;
+    case board::PieceType::KING:
+      return 0;
+  }
+  __builtin_unreachable();
+}
+}
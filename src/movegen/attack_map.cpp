@@ -0,0 +1,74 @@
+#include "movegen/attack_map.h"
+
+#include <boost/assert.hpp>
+
+#include "board/piece_type.h"
+
+namespace prodigy::movegen {
+AttackMap::AttackMap(const Tables& tables, const board::Position& position) {
+  const auto occupancy = position.occupancy();
+  board::for_each_coordinate(occupancy, [&](const auto coordinate) {
+    toggle<true>(tables, position.piece_at(coordinate), coordinate, occupancy);
+  });
+}
+
+void AttackMap::update(const Tables& tables, const board::Position& before, const board::Position& after) {
+  const auto before_occupancy = before.occupancy();
+  const auto after_occupancy = after.occupancy();
+  // Besides the squares that were emptied or filled, a capture or a promotion changes the piece on its target.
+  const auto changed_piece_set = [&]<board::Color COLOR> {
+    const auto changed_pieces = [&]<board::PieceType PIECE_TYPE> {
+      return before.pieces<COLOR, PIECE_TYPE>() ^ after.pieces<COLOR, PIECE_TYPE>();
+    };
+    return changed_pieces.template operator()<board::PieceType::PAWN>() |
+           changed_pieces.template operator()<board::PieceType::KNIGHT>() |
+           changed_pieces.template operator()<board::PieceType::BISHOP>() |
+           changed_pieces.template operator()<board::PieceType::ROOK>() |
+           changed_pieces.template operator()<board::PieceType::QUEEN>() |
+           changed_pieces.template operator()<board::PieceType::KING>();
+  };
+  const auto changed_set = changed_piece_set.template operator()<board::Color::WHITE>() |
+                           changed_piece_set.template operator()<board::Color::BLACK>();
+  // Sliders off the changed squares are the same before and after, but may see through or stop at the changed squares.
+  // The path from such a slider to the nearest changed square along a ray is the same before and after, so looking from
+  // the changed squares through the occupancy before the move finds every one of them.
+  const auto diagonal_sliders =
+      before.pieces<board::Color::WHITE, board::PieceType::BISHOP, board::PieceType::QUEEN>() |
+      before.pieces<board::Color::BLACK, board::PieceType::BISHOP, board::PieceType::QUEEN>();
+  const auto orthogonal_sliders =
+      before.pieces<board::Color::WHITE, board::PieceType::ROOK, board::PieceType::QUEEN>() |
+      before.pieces<board::Color::BLACK, board::PieceType::ROOK, board::PieceType::QUEEN>();
+  board::Bitboard crossing_sliders;
+  board::for_each_coordinate(changed_set, [&](const auto coordinate) {
+    crossing_sliders |=
+        (tables.attack_set<board::Color::WHITE, board::PieceType::BISHOP>(coordinate, before_occupancy) &
+         diagonal_sliders) |
+        (tables.attack_set<board::Color::WHITE, board::PieceType::ROOK>(coordinate, before_occupancy) &
+         orthogonal_sliders);
+  });
+  crossing_sliders &= ~changed_set;
+
+  board::for_each_coordinate((changed_set & before_occupancy) | crossing_sliders, [&](const auto coordinate) {
+    toggle<false>(tables, before.piece_at(coordinate), coordinate, before_occupancy);
+  });
+  board::for_each_coordinate((changed_set & after_occupancy) | crossing_sliders, [&](const auto coordinate) {
+    toggle<true>(tables, after.piece_at(coordinate), coordinate, after_occupancy);
+  });
+}
+
+template <bool ADD>
+void AttackMap::toggle(const Tables& tables, const board::Piece piece, const board::Coordinate coordinate,
+                       const board::Bitboard occupancy) {
+  BOOST_ASSERT(piece);
+  auto carry = piece.color() == board::Color::WHITE
+                   ? tables.attack_set<board::Color::WHITE>(piece.piece_type(), coordinate, occupancy)
+                   : tables.attack_set<board::Color::BLACK>(piece.piece_type(), coordinate, occupancy);
+  // Ripple-carry addition or subtraction of one on every square in the attack set.
+  for (auto& count : color_to_counts_[piece.color()]) {
+    const auto next_carry = (ADD ? count : ~count) & carry;
+    count ^= carry;
+    carry = next_carry;
+  }
+  BOOST_ASSERT(!carry);
+}
+}
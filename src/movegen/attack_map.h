@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/color_map.h"
+#include "board/coordinate.h"
+#include "board/piece.h"
+#include "board/position.h"
+#include "movegen/tables.h"
+
+namespace prodigy::movegen {
+// The squares each color attacks and how many of its pieces attack each of them, kept alongside a position by whoever
+// needs them. Counts are bit-sliced: bit i of a square's count is that square's bit in the i-th bitboard, so adding or
+// removing a whole attack set is a handful of bitwise operations.
+class AttackMap final {
+ public:
+  // Computes the attack map of the position from scratch.
+  AttackMap(const Tables&, const board::Position&);
+
+  template <board::Color COLOR>
+  board::Bitboard attack_set() const {
+    const auto& counts = color_to_counts_[COLOR];
+    return counts[0] | counts[1] | counts[2] | counts[3] | counts[4];
+  }
+
+  template <board::Color COLOR>
+  int attacker_count(const board::Coordinate coordinate) const {
+    auto attacker_count = 0;
+    for (auto i = 0UZ; i < COUNT_BITS; ++i) {
+      attacker_count |= static_cast<bool>(color_to_counts_[COLOR][i] & board::Bitboard(coordinate)) << i;
+    }
+    return attacker_count;
+  }
+
+  // Updates the attack map of the position before a move into that of the position after it. Only the pieces on the
+  // squares the move changes, and the sliders whose rays cross those squares, are recomputed.
+  void update(const Tables&, const board::Position& before, const board::Position& after);
+
+  friend bool operator==(const AttackMap&, const AttackMap&) = default;
+
+ private:
+  // A square is attacked at most once along each of the eight slider directions and from each of the eight knight
+  // squares.
+  static constexpr auto COUNT_BITS = 5UZ;
+
+  using Counts = std::array<board::Bitboard, COUNT_BITS>;
+
+  // Adds or removes the attack set of the piece on the coordinate through the occupancy.
+  template <bool ADD>
+  void toggle(const Tables&, board::Piece, board::Coordinate, board::Bitboard occupancy);
+
+  board::ColorMap<Counts> color_to_counts_;
+};
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+namespace prodigy::movegen {
+// Callers must check is_supported(SliderBackend::PEXT) first: unless the build targets BMI2, the instruction is emitted
+// unconditionally so that lookups stay inlinable without a BMI2 target attribute.
+inline std::uint64_t pext(const std::uint64_t source, const std::uint64_t mask) {
+#ifdef __BMI2__
+  return _pext_u64(source, mask);
+#else
+  std::uint64_t result;
+  asm("pextq %2, %1, %0" : "=r"(result) : "r"(source), "rm"(mask));
+  return result;
+#endif
+}
+}
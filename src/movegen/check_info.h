@@ -0,0 +1,20 @@
+#pragma once
+
+#include "board/bitboard.h"
+#include "board/piece_type_map.h"
+
+namespace prodigy::movegen {
+// What the side to move needs to know about checks at a node, computed once by MoveGenerator::check_info and shared by
+// move generation and the search.
+struct CheckInfo final {
+  // The enemy pieces attacking the king.
+  board::Bitboard checkers;
+  // The pieces that would expose the king to an enemy slider by leaving the line between them.
+  board::Bitboard pinned;
+  board::Bitboard pinners;
+  // The pieces that would give discovered check by leaving the line between one of their sliders and the enemy king.
+  board::Bitboard discovered_check_candidates;
+  // The squares from which each piece type would attack the enemy king. There are none for the king.
+  board::PieceTypeMap<board::Bitboard> check_squares;
+};
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace prodigy::movegen {
+enum class GenerationType : std::uint8_t {
+  // Captures, including en passant, and promotions to a queen.
+  CAPTURES,
+  // Every other move, including underpromotions and castles.
+  QUIETS,
+  // Every move out of check. The active king must be in check.
+  EVASIONS,
+  ALL,
+};
+
+constexpr bool includes_captures(const GenerationType generation_type) {
+  return generation_type != GenerationType::QUIETS;
+}
+
+constexpr bool includes_quiets(const GenerationType generation_type) {
+  return generation_type != GenerationType::CAPTURES;
+}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "board/bitboard.h"
+#include "board/coordinate.h"
+#include "board/coordinate_map.h"
+#include "board/file.h"
+#include "board/rank.h"
+
+namespace prodigy::movegen {
+// Computes slider attack sets from a few KB of line masks instead of one table entry per occupancy. Subtracting the
+// origin from the occupancy of a line borrows up to the nearest blocker above the origin, and byte swapping mirrors
+// the ranks so that the same subtraction finds the nearest blocker below it. Ranks are not mirrored by a byte swap, so
+// they are looked up in a table of first rank attack sets instead.
+class HyperbolaQuintessence final {
+ public:
+  constexpr HyperbolaQuintessence()
+      : origin_to_record_([] {
+          board::CoordinateMap<Record> origin_to_record;
+          board::for_each_coordinate([&](const auto origin) {
+            auto& [file_mask, diagonal_mask, anti_diagonal_mask] = origin_to_record[origin];
+            board::for_each_coordinate([&](const auto target) {
+              if (target == origin) {
+                return;
+              }
+              const auto file_offset = std::to_underlying(file_of(target)) - std::to_underlying(file_of(origin));
+              const auto rank_offset = std::to_underlying(rank_of(target)) - std::to_underlying(rank_of(origin));
+              if (file_offset == 0) {
+                file_mask |= board::Bitboard(target);
+              } else if (file_offset == rank_offset) {
+                diagonal_mask |= board::Bitboard(target);
+              } else if (file_offset == -rank_offset) {
+                anti_diagonal_mask |= board::Bitboard(target);
+              }
+            });
+          });
+          return origin_to_record;
+        }()),
+        first_rank_attack_table_([] {
+          std::array<std::array<std::uint8_t, 64>, 8> first_rank_attack_table{};
+          for (auto file = 0; file < 8; ++file) {
+            for (auto inner_occupancy = 0; inner_occupancy < 64; ++inner_occupancy) {
+              auto& attack_set =
+                  first_rank_attack_table[static_cast<std::size_t>(file)][static_cast<std::size_t>(inner_occupancy)];
+              const auto occupancy = inner_occupancy << 1;
+              for (auto target = file + 1; target < 8; ++target) {
+                attack_set |= 1 << target;
+                if (occupancy & 1 << target) {
+                  break;
+                }
+              }
+              for (auto target = file - 1; target >= 0; --target) {
+                attack_set |= 1 << target;
+                if (occupancy & 1 << target) {
+                  break;
+                }
+              }
+            }
+          }
+          return first_rank_attack_table;
+        }()) {}
+
+  HyperbolaQuintessence(const HyperbolaQuintessence&) = delete;
+  HyperbolaQuintessence& operator=(const HyperbolaQuintessence&) = delete;
+
+  board::Bitboard bishop_attack_set(const board::Coordinate origin, const board::Bitboard occupancy) const {
+    const auto& record = origin_to_record_[origin];
+    return line_attack_set(origin, occupancy, record.diagonal_mask) |
+           line_attack_set(origin, occupancy, record.anti_diagonal_mask);
+  }
+
+  board::Bitboard rook_attack_set(const board::Coordinate origin, const board::Bitboard occupancy) const {
+    const auto rank_shift = 8 * std::to_underlying(rank_of(origin));
+    const auto inner_occupancy = occupancy.underlying() >> (rank_shift + 1) & 0x3f;
+    const std::uint64_t rank_attack_set =
+        first_rank_attack_table_[std::to_underlying(file_of(origin))][inner_occupancy];
+    return line_attack_set(origin, occupancy, origin_to_record_[origin].file_mask) |
+           std::bit_cast<board::Bitboard>(rank_attack_set << rank_shift);
+  }
+
+ private:
+  struct Record {
+    board::Bitboard file_mask;
+    board::Bitboard diagonal_mask;
+    board::Bitboard anti_diagonal_mask;
+  };
+
+  static board::Bitboard line_attack_set(const board::Coordinate origin, const board::Bitboard occupancy,
+                                         const board::Bitboard mask) {
+    const auto line_occupancy = (occupancy & mask).underlying();
+    const auto origin_bit = board::Bitboard(origin).underlying();
+    const auto forward = line_occupancy - origin_bit;
+    const auto reverse = std::byteswap(std::byteswap(line_occupancy) - std::byteswap(origin_bit));
+    return std::bit_cast<board::Bitboard>(forward ^ reverse) & mask;
+  }
+
+  const board::CoordinateMap<Record> origin_to_record_;
+  const std::array<std::array<std::uint8_t, 64>, 8> first_rank_attack_table_;
+};
+}
@@ -0,0 +1,17 @@
+#include "movegen/king_danger.h"
+
+#include <ostream>
+
+namespace prodigy::movegen {
+std::ostream& operator<<(std::ostream& os, const KingDanger king_danger) {
+  switch (king_danger) {
+    case KingDanger::EAGER:
+      os << "eager";
+      break;
+    case KingDanger::LAZY:
+      os << "lazy";
+      break;
+  }
+  return os;
+}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+namespace prodigy::movegen {
+// How the move generator finds the squares its king must not move to.
+enum class KingDanger : std::uint8_t {
+  // Computes every square the enemy attacks through the king up front.
+  EAGER,
+  // Asks whether the enemy attacks each square only for the king targets and castling paths that need it.
+  LAZY,
+};
+
+inline constexpr std::array KING_DANGERS = {
+    KingDanger::EAGER,
+    KingDanger::LAZY,
+};
+
+std::ostream& operator<<(std::ostream&, KingDanger);
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
+#include <boost/assert.hpp>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <vector>
+#include <utility>
 
 #include "board/bitboard.h"
 #include "board/coordinate.h"
@@ -10,26 +13,67 @@
 
 namespace prodigy::movegen {
 using Magic = std::uint64_t;
-using AttackTable = std::vector<board::Bitboard>;
 
+// Fancy magic bitboards: the attack sets of every origin are packed into one flat table, each origin owning
+// 2^popcount(mask) entries starting at its offset.
+template <std::size_t ATTACK_TABLE_SIZE>
 class MagicBitboards final {
  public:
-  MagicBitboards(const std::function<bool(board::Coordinate origin, board::Coordinate target)>& mask_contains,
-                 const std::function<board::Bitboard(board::Coordinate origin, board::Bitboard occupancy)>& attack_set);
+  template <std::predicate<board::Coordinate, board::Coordinate> MaskContains,
+            std::invocable<board::Coordinate, board::Bitboard> AttackSet>
+  constexpr MagicBitboards(const std::array<Magic, 64>& magics, MaskContains&& mask_contains, AttackSet&& attack_set)
+      : origin_to_record_([&] {
+          board::CoordinateMap<Record> origin_to_record;
+          std::uint32_t offset = 0;
+          board::for_each_coordinate([&](const auto origin) {
+            auto& [mask, magic, shift, record_offset] = origin_to_record[origin];
+            board::for_each_coordinate([&](const auto target) {
+              if (target != origin && std::forward<MaskContains>(mask_contains)(origin, target)) {
+                mask |= board::Bitboard(target);
+              }
+            });
+            magic = magics[std::to_underlying(origin)];
+            shift = static_cast<std::uint8_t>(64 - mask.popcount());
+            record_offset = offset;
+            offset += 1U << mask.popcount();
+          });
+          BOOST_ASSERT(offset == ATTACK_TABLE_SIZE);
+          return origin_to_record;
+        }()),
+        attack_table_([&] {
+          std::array<board::Bitboard, ATTACK_TABLE_SIZE> attack_table;
+          board::for_each_coordinate([&](const auto origin) {
+            const auto& [mask, magic, shift, offset] = origin_to_record_[origin];
+            auto occupancy = board::Bitboard();
+            do {
+              auto& attack_table_entry = attack_table[offset + (occupancy.underlying() * magic >> shift)];
+              const auto occupancy_attack_set = std::forward<AttackSet>(attack_set)(origin, occupancy);
+              // Sliders always attack something, so only empty entries are unclaimed.
+              BOOST_ASSERT(!attack_table_entry || attack_table_entry == occupancy_attack_set);
+              attack_table_entry = occupancy_attack_set;
+              occupancy = occupancy.next_subset(mask);
+            } while (occupancy);
+          });
+          return attack_table;
+        }()) {}
 
   MagicBitboards(const MagicBitboards&) = delete;
   MagicBitboards& operator=(const MagicBitboards&) = delete;
 
-  board::Bitboard attack_set(board::Coordinate origin, board::Bitboard occupancy) const;
+  constexpr board::Bitboard attack_set(const board::Coordinate origin, const board::Bitboard occupancy) const {
+    const auto& [mask, magic, shift, offset] = origin_to_record_[origin];
+    return attack_table_[offset + ((occupancy & mask).underlying() * magic >> shift)];
+  }
 
  private:
   struct Record {
     board::Bitboard mask;
     Magic magic;
     std::uint8_t shift;
-    AttackTable attack_table;
+    std::uint32_t offset;
   };
 
   const board::CoordinateMap<Record> origin_to_record_;
+  const std::array<board::Bitboard, ATTACK_TABLE_SIZE> attack_table_;
 };
 }
@@ -3,46 +3,380 @@
 #include <boost/assert.hpp>
 
 #include "board/color_traits.h"
-#include "board/coordinate_map.h"
 #include "board/direction.h"
+#include "eval/piece_value.h"
 
 namespace prodigy::movegen {
 template <board::Color COLOR, board::PieceType PIECE_TYPE>
 inline board::Bitboard MoveGenerator::pseudo_legal_move_set(const board::Position& position,
                                                             const board::Coordinate origin,
                                                             const board::Bitboard occupancy) const {
-  if constexpr (PIECE_TYPE == board::PieceType::PAWN) {
-    using ColorTraits = board::ColorTraits<COLOR>;
-    const auto single_push_target = board::unsafe_directional_offset<ColorTraits::RELATIVE_NORTH>(origin);
-    auto push_set = board::Bitboard(single_push_target) & ~occupancy;
-    if (push_set && rank_of(origin) == ColorTraits::PAWN_INITIAL_RANK) {
-      if (const auto double_push_target = board::directional_offset<ColorTraits::RELATIVE_NORTH>(single_push_target);
-          double_push_target.has_value()) {
-        push_set |= board::Bitboard(*double_push_target) & ~occupancy;
+  static_assert(PIECE_TYPE != board::PieceType::PAWN);
+  return tables_.attack_set<COLOR, PIECE_TYPE>(origin, occupancy) & ~position.all_pieces<COLOR>();
+}
+
+template <board::Color SLIDER_COLOR>
+inline board::Bitboard MoveGenerator::xray_slider_set(const board::Position& position,
+                                                      const board::Coordinate king_coordinate,
+                                                      const board::Bitboard blocker_set) const {
+  const auto occupancy = position.occupancy();
+  const auto xray_attack_set = [&]<board::PieceType PIECE_TYPE> {
+    const auto attack_set = tables_.attack_set<SLIDER_COLOR, PIECE_TYPE>(king_coordinate, occupancy);
+    return attack_set ^
+           tables_.attack_set<SLIDER_COLOR, PIECE_TYPE>(king_coordinate, occupancy ^ (blocker_set & attack_set));
+  };
+  return (xray_attack_set.template operator()<board::PieceType::BISHOP>() &
+          position.pieces<SLIDER_COLOR, board::PieceType::BISHOP, board::PieceType::QUEEN>()) |
+         (xray_attack_set.template operator()<board::PieceType::ROOK>() &
+          position.pieces<SLIDER_COLOR, board::PieceType::ROOK, board::PieceType::QUEEN>());
+}
+
+template <board::Color ACTIVE_COLOR>
+inline bool MoveGenerator::is_attacked(const board::Position& position, const board::Coordinate coordinate,
+                                       const board::Bitboard occupancy) const {
+  return static_cast<bool>(
+      (tables_.attack_set<ACTIVE_COLOR, board::PieceType::PAWN>(coordinate, occupancy) &
+       position.pieces<~ACTIVE_COLOR, board::PieceType::PAWN>()) |
+      (tables_.attack_set<ACTIVE_COLOR, board::PieceType::KNIGHT>(coordinate, occupancy) &
+       position.pieces<~ACTIVE_COLOR, board::PieceType::KNIGHT>()) |
+      (tables_.attack_set<ACTIVE_COLOR, board::PieceType::KING>(coordinate, occupancy) &
+       position.pieces<~ACTIVE_COLOR, board::PieceType::KING>()) |
+      (tables_.attack_set<ACTIVE_COLOR, board::PieceType::BISHOP>(coordinate, occupancy) &
+       position.pieces<~ACTIVE_COLOR, board::PieceType::BISHOP, board::PieceType::QUEEN>()) |
+      (tables_.attack_set<ACTIVE_COLOR, board::PieceType::ROOK>(coordinate, occupancy) &
+       position.pieces<~ACTIVE_COLOR, board::PieceType::ROOK, board::PieceType::QUEEN>()));
+}
+
+template <board::Color ACTIVE_COLOR>
+inline CheckInfo MoveGenerator::checkers_and_pins(const board::Position& position) const {
+  const auto occupancy = position.occupancy();
+  const auto king_coordinate = unsafe_to_coordinate(position.pieces<ACTIVE_COLOR, board::PieceType::KING>());
+  CheckInfo check_info;
+  const auto attacker_set = [&]<board::PieceType PIECE_TYPE> {
+    return tables_.attack_set<ACTIVE_COLOR, PIECE_TYPE>(king_coordinate, occupancy) &
+           position.pieces<~ACTIVE_COLOR, PIECE_TYPE>();
+  };
+  check_info.checkers = attacker_set.template operator()<board::PieceType::PAWN>() |
+                        attacker_set.template operator()<board::PieceType::KNIGHT>() |
+                        attacker_set.template operator()<board::PieceType::BISHOP>() |
+                        attacker_set.template operator()<board::PieceType::ROOK>() |
+                        attacker_set.template operator()<board::PieceType::QUEEN>();
+  check_info.pinners = xray_slider_set<~ACTIVE_COLOR>(position, king_coordinate, position.all_pieces<ACTIVE_COLOR>());
+  for_each_coordinate(check_info.pinners, [&](const auto pinner) {
+    check_info.pinned |= tables_.ray(king_coordinate, pinner) & position.all_pieces<ACTIVE_COLOR>();
+  });
+  return check_info;
+}
+
+template <board::Color ACTIVE_COLOR>
+CheckInfo MoveGenerator::check_info(const board::Position& position) const {
+  auto check_info = checkers_and_pins<ACTIVE_COLOR>(position);
+  const auto occupancy = position.occupancy();
+  const auto enemy_king_coordinate = unsafe_to_coordinate(position.pieces<~ACTIVE_COLOR, board::PieceType::KING>());
+  auto& check_squares = check_info.check_squares;
+  // Attacks are symmetric, except that pawns attack forwards, so the enemy king looks back with enemy pawn attacks.
+  const auto check_square_set = [&]<board::PieceType PIECE_TYPE> {
+    check_squares[PIECE_TYPE] = tables_.attack_set<~ACTIVE_COLOR, PIECE_TYPE>(enemy_king_coordinate, occupancy);
+  };
+  check_square_set.template operator()<board::PieceType::PAWN>();
+  check_square_set.template operator()<board::PieceType::KNIGHT>();
+  check_square_set.template operator()<board::PieceType::BISHOP>();
+  check_square_set.template operator()<board::PieceType::ROOK>();
+  check_squares[board::PieceType::QUEEN] =
+      check_squares[board::PieceType::BISHOP] | check_squares[board::PieceType::ROOK];
+  for_each_coordinate(
+      xray_slider_set<ACTIVE_COLOR>(position, enemy_king_coordinate, position.all_pieces<ACTIVE_COLOR>()),
+      [&](const auto slider) {
+        check_info.discovered_check_candidates |=
+            tables_.ray(slider, enemy_king_coordinate) & position.all_pieces<ACTIVE_COLOR>();
+      });
+  return check_info;
+}
+
+template <board::Color ACTIVE_COLOR>
+bool MoveGenerator::is_pseudo_legal(const board::Position& position, const CheckInfo& check_info,
+                                    const board::Move move) const {
+  using ActiveColorTraits = board::ColorTraits<ACTIVE_COLOR>;
+  const auto origin = move.origin();
+  const auto target = move.target();
+  const auto piece = position.piece_at(origin);
+  if (!piece || piece.color() != ACTIVE_COLOR || position.all_pieces<ACTIVE_COLOR>() & board::Bitboard(target)) {
+    return false;
+  }
+  const auto occupancy = position.occupancy();
+  const auto promotion = move.promotion();
+  const auto king_coordinate = unsafe_to_coordinate(position.pieces<ACTIVE_COLOR, board::PieceType::KING>());
+  if (piece.piece_type() == board::PieceType::KING) {
+    if (promotion.has_value()) {
+      return false;
+    }
+    if (tables_.attack_set<ACTIVE_COLOR, board::PieceType::KING>(origin, occupancy) & board::Bitboard(target)) {
+      return true;
+    }
+    // Castling out of check is never legal, and castling through check is left to is_legal.
+    const auto can_castle = [&](const auto castling_rights, const auto king_target, const auto rook_origin) {
+      return target == king_target &&
+             (position.castling_rights() & castling_rights) != board::CastlingRights::NONE &&
+             (tables_.ray(origin, rook_origin) & occupancy) == board::Bitboard(rook_origin);
+    };
+    return origin == ActiveColorTraits::KING_INITIAL_ORIGIN && !check_info.checkers &&
+           (can_castle(ActiveColorTraits::KINGSIDE_CASTLING_RIGHTS, ActiveColorTraits::KING_KINGSIDE_CASTLE_TARGET,
+                       ActiveColorTraits::KINGSIDE_ROOK_INITIAL_ORIGIN) ||
+            can_castle(ActiveColorTraits::QUEENSIDE_CASTLING_RIGHTS, ActiveColorTraits::KING_QUEENSIDE_CASTLE_TARGET,
+                       ActiveColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN));
+  }
+  // Only the king can answer a double check. Anything else must capture the checker or block its ray.
+  if (check_info.checkers.popcount() > 1) {
+    return false;
+  }
+  const auto check_evasion_mask =
+      check_info.checkers
+          ? check_info.checkers | tables_.ray(king_coordinate, unsafe_to_coordinate(check_info.checkers))
+          : ~board::Bitboard();
+  if (piece.piece_type() != board::PieceType::PAWN) {
+    return !promotion.has_value() &&
+           static_cast<bool>(tables_.attack_set<ACTIVE_COLOR>(piece.piece_type(), origin, occupancy) &
+                             check_evasion_mask & board::Bitboard(target));
+  }
+  const auto is_promotion = static_cast<bool>(board::Bitboard(ActiveColorTraits::PAWN_PROMOTION_RANK) &
+                                              board::Bitboard(target));
+  if (is_promotion != promotion.has_value() ||
+      (is_promotion && (*promotion == board::PieceType::PAWN || *promotion > board::PieceType::QUEEN))) {
+    return false;
+  }
+  const auto pawn = board::Bitboard(origin);
+  const auto single_push_set = pawn.template shift<ActiveColorTraits::RELATIVE_NORTH>() & ~occupancy;
+  const auto double_push_set = single_push_set.template shift<ActiveColorTraits::RELATIVE_NORTH>() & ~occupancy &
+                               board::Bitboard(ActiveColorTraits::PAWN_DOUBLE_PUSH_TARGET_RANK);
+  const auto capture_set = tables_.attack_set<ACTIVE_COLOR, board::PieceType::PAWN>(origin, occupancy);
+  if ((single_push_set | double_push_set | (capture_set & position.all_pieces<~ACTIVE_COLOR>())) &
+      check_evasion_mask & board::Bitboard(target)) {
+    return true;
+  }
+  // En passant also evades a check by capturing the pawn that just gave it.
+  const auto en_passant_target = position.en_passant_target();
+  if (target != en_passant_target || !(capture_set & board::Bitboard(target))) {
+    return false;
+  }
+  const auto en_passant_target_pawn =
+      board::Bitboard(board::unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(target));
+  return static_cast<bool>((board::Bitboard(target) | en_passant_target_pawn) & check_evasion_mask);
+}
+
+template <board::Color ACTIVE_COLOR>
+bool MoveGenerator::is_legal(const board::Position& position, const CheckInfo& check_info,
+                             const board::Move move) const {
+  using ActiveColorTraits = board::ColorTraits<ACTIVE_COLOR>;
+  BOOST_ASSERT(is_pseudo_legal<ACTIVE_COLOR>(position, check_info, move));
+  const auto origin = move.origin();
+  const auto target = move.target();
+  const auto occupancy = position.occupancy();
+  const auto king = position.pieces<ACTIVE_COLOR, board::PieceType::KING>();
+  const auto king_coordinate = unsafe_to_coordinate(king);
+  if (origin == king_coordinate) {
+    if (tables_.attack_set<ACTIVE_COLOR, board::PieceType::KING>(origin, occupancy) & board::Bitboard(target)) {
+      // The king no longer blocks the sliders attacking it along the line it moves.
+      return !is_attacked<ACTIVE_COLOR>(position, target, occupancy ^ king);
+    }
+    auto is_path_attacked = false;
+    for_each_coordinate(tables_.ray(origin, target), [&](const auto coordinate) {
+      is_path_attacked |= is_attacked<ACTIVE_COLOR>(position, coordinate, occupancy);
+    });
+    return !is_path_attacked;
+  }
+  if (position.piece_at(origin).piece_type() == board::PieceType::PAWN && target == position.en_passant_target()) {
+    const auto en_passant_target_pawn =
+        board::Bitboard(board::unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(target));
+    const auto occupancy_after_en_passant =
+        (occupancy ^ board::Bitboard(origin) ^ en_passant_target_pawn) | board::Bitboard(target);
+    return !(tables_.attack_set<ACTIVE_COLOR, board::PieceType::BISHOP>(king_coordinate, occupancy_after_en_passant) &
+             position.pieces<~ACTIVE_COLOR, board::PieceType::BISHOP, board::PieceType::QUEEN>()) &&
+           !(tables_.attack_set<ACTIVE_COLOR, board::PieceType::ROOK>(king_coordinate, occupancy_after_en_passant) &
+             position.pieces<~ACTIVE_COLOR, board::PieceType::ROOK, board::PieceType::QUEEN>());
+  }
+  return !(check_info.pinned & board::Bitboard(origin)) ||
+         static_cast<bool>(tables_.line(king_coordinate, origin) & board::Bitboard(target));
+}
+
+template <board::Color ACTIVE_COLOR>
+bool MoveGenerator::gives_check(const board::Position& position, const CheckInfo& check_info,
+                                const board::Move move) const {
+  using ActiveColorTraits = board::ColorTraits<ACTIVE_COLOR>;
+  BOOST_ASSERT(move == position.annotate<ACTIVE_COLOR>(board::Move(move.origin(), move.target(), move.promotion())));
+  const auto origin = move.origin();
+  const auto target = move.target();
+  const auto promotion = move.promotion();
+  const auto enemy_king = position.pieces<~ACTIVE_COLOR, board::PieceType::KING>();
+  const auto enemy_king_coordinate = unsafe_to_coordinate(enemy_king);
+  if (!promotion.has_value() && check_info.check_squares[move.piece_type()] & board::Bitboard(target)) {
+    return true;
+  }
+  if (check_info.discovered_check_candidates & board::Bitboard(origin) &&
+      !(tables_.line(enemy_king_coordinate, origin) & board::Bitboard(target))) {
+    return true;
+  }
+  const auto occupancy = position.occupancy();
+  switch (move.kind()) {
+    case board::Move::Kind::NORMAL: {
+      if (!promotion.has_value()) {
+        return false;
       }
+      // A promotion attacks through the square its pawn leaves.
+      const auto occupancy_after_promotion = occupancy ^ board::Bitboard(origin);
+      return static_cast<bool>(tables_.attack_set<ACTIVE_COLOR>(*promotion, target, occupancy_after_promotion) &
+                               enemy_king);
+    }
+    case board::Move::Kind::DOUBLE_PUSH:
+      return false;
+    case board::Move::Kind::EN_PASSANT: {
+      // The captured pawn can uncover a check that no candidate accounts for.
+      const auto en_passant_target_pawn =
+          board::Bitboard(board::unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(target));
+      const auto occupancy_after_en_passant =
+          (occupancy ^ board::Bitboard(origin) ^ en_passant_target_pawn) | board::Bitboard(target);
+      return static_cast<bool>(
+          (tables_.attack_set<ACTIVE_COLOR, board::PieceType::BISHOP>(enemy_king_coordinate,
+                                                                      occupancy_after_en_passant) &
+           position.pieces<ACTIVE_COLOR, board::PieceType::BISHOP, board::PieceType::QUEEN>()) |
+          (tables_.attack_set<ACTIVE_COLOR, board::PieceType::ROOK>(enemy_king_coordinate, occupancy_after_en_passant) &
+           position.pieces<ACTIVE_COLOR, board::PieceType::ROOK, board::PieceType::QUEEN>()));
+    }
+    case board::Move::Kind::CASTLE: {
+      const auto is_kingside = target == ActiveColorTraits::KING_KINGSIDE_CASTLE_TARGET;
+      const auto rook_origin = is_kingside ? ActiveColorTraits::KINGSIDE_ROOK_INITIAL_ORIGIN
+                                           : ActiveColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN;
+      const auto rook_target = is_kingside ? ActiveColorTraits::KINGSIDE_ROOK_CASTLE_TARGET
+                                           : ActiveColorTraits::QUEENSIDE_ROOK_CASTLE_TARGET;
+      const auto occupancy_after_castle = (occupancy ^ board::Bitboard(origin) ^ board::Bitboard(rook_origin)) |
+                                          board::Bitboard(target) | board::Bitboard(rook_target);
+      return static_cast<bool>(
+          tables_.attack_set<ACTIVE_COLOR, board::PieceType::ROOK>(rook_target, occupancy_after_castle) & enemy_king);
     }
-    return (tables_.attack_set<COLOR, PIECE_TYPE>(origin, occupancy) & position.all_pieces<~COLOR>()) | push_set;
-  } else {
-    return tables_.attack_set<COLOR, PIECE_TYPE>(origin, occupancy) & ~position.all_pieces<COLOR>();
   }
+  __builtin_unreachable();
+}
+
+board::Bitboard MoveGenerator::attackers_to(const board::Position& position, const board::Coordinate coordinate,
+                                            const board::Bitboard occupancy) const {
+  using enum board::Color;
+  using enum board::PieceType;
+  return (tables_.attack_set<WHITE, PAWN>(coordinate, occupancy) & position.pieces<BLACK, PAWN>()) |
+         (tables_.attack_set<BLACK, PAWN>(coordinate, occupancy) & position.pieces<WHITE, PAWN>()) |
+         (tables_.attack_set<WHITE, KNIGHT>(coordinate, occupancy) &
+          (position.pieces<WHITE, KNIGHT>() | position.pieces<BLACK, KNIGHT>())) |
+         (tables_.attack_set<WHITE, BISHOP>(coordinate, occupancy) &
+          (position.pieces<WHITE, BISHOP, QUEEN>() | position.pieces<BLACK, BISHOP, QUEEN>())) |
+         (tables_.attack_set<WHITE, ROOK>(coordinate, occupancy) &
+          (position.pieces<WHITE, ROOK, QUEEN>() | position.pieces<BLACK, ROOK, QUEEN>())) |
+         (tables_.attack_set<WHITE, KING>(coordinate, occupancy) &
+          (position.pieces<WHITE, KING>() | position.pieces<BLACK, KING>()));
 }
 
 template <board::Color ACTIVE_COLOR>
-MoveList MoveGenerator::generate(const board::Position& position) const {
+bool MoveGenerator::see_ge(const board::Position& position, const board::Move move,
+                           const eval::Score threshold) const {
+  using enum board::PieceType;
+  if (move.kind() == board::Move::Kind::CASTLE) {
+    return threshold <= 0;
+  }
+  const auto origin = move.origin();
+  const auto target = move.target();
+  const auto promotion = move.promotion();
+  // The balance is what the side that just captured is ahead by, less the threshold, if the other side stops.
+  auto balance = (move.is_capture() ? eval::piece_value(move.captured()) : 0) - threshold;
+  if (promotion.has_value()) {
+    balance += eval::piece_value(*promotion) - eval::piece_value(PAWN);
+  }
+  if (balance < 0) {
+    return false;
+  }
+  // From here, what the other side is ahead by, less its threshold, if it recaptures and loses its piece in turn.
+  balance = eval::piece_value(promotion.value_or(move.piece_type())) - balance;
+  if (balance <= 0) {
+    return true;
+  }
+  auto occupancy = position.occupancy() ^ board::Bitboard(origin);
+  if (move.kind() == board::Move::Kind::EN_PASSANT) {
+    occupancy ^= board::Bitboard(
+        board::unsafe_directional_offset<board::ColorTraits<ACTIVE_COLOR>::RELATIVE_SOUTH>(target));
+  }
+  const auto diagonal_sliders = position.pieces<board::Color::WHITE, BISHOP, QUEEN>() |
+                                position.pieces<board::Color::BLACK, BISHOP, QUEEN>();
+  const auto orthogonal_sliders =
+      position.pieces<board::Color::WHITE, ROOK, QUEEN>() | position.pieces<board::Color::BLACK, ROOK, QUEEN>();
+  const auto white_pieces = position.all_pieces<board::Color::WHITE>();
+  auto attackers = attackers_to(position, target, occupancy);
+  auto side = ACTIVE_COLOR;
+  // Whether the side that made the move wins the exchange if it ended with the last capture so far.
+  auto wins = true;
+  while (true) {
+    side = ~side;
+    attackers &= occupancy;
+    const auto side_attackers = attackers & (side == board::Color::WHITE ? white_pieces : ~white_pieces);
+    if (!side_attackers) {
+      break;
+    }
+    wins = !wins;
+    // Captures with an attacker of the piece type, if there is one, and uncovers the sliders lined up behind it.
+    const auto capture_with = [&]<board::PieceType PIECE_TYPE> {
+      const auto attacker =
+          (side_attackers &
+           (position.pieces<board::Color::WHITE, PIECE_TYPE>() | position.pieces<board::Color::BLACK, PIECE_TYPE>()))
+              .lsb();
+      if (!attacker) {
+        return false;
+      }
+      balance = eval::piece_value(PIECE_TYPE) - balance;
+      occupancy ^= attacker;
+      if constexpr (PIECE_TYPE == PAWN || PIECE_TYPE == BISHOP || PIECE_TYPE == QUEEN) {
+        attackers |= tables_.attack_set<ACTIVE_COLOR, BISHOP>(target, occupancy) & diagonal_sliders;
+      }
+      if constexpr (PIECE_TYPE == ROOK || PIECE_TYPE == QUEEN) {
+        attackers |= tables_.attack_set<ACTIVE_COLOR, ROOK>(target, occupancy) & orthogonal_sliders;
+      }
+      return true;
+    };
+    if (capture_with.template operator()<PAWN>() || capture_with.template operator()<KNIGHT>() ||
+        capture_with.template operator()<BISHOP>() || capture_with.template operator()<ROOK>() ||
+        capture_with.template operator()<QUEEN>()) {
+      // Ends the exchange once recapturing can no longer change its outcome.
+      if (balance < static_cast<eval::Score>(wins)) {
+        break;
+      }
+      continue;
+    }
+    // Only the king is left, which can only capture if the other side has no attackers left.
+    return static_cast<bool>(attackers & ~side_attackers) ? !wins : wins;
+  }
+  return wins;
+}
+
+template <board::Color ACTIVE_COLOR, GenerationType GENERATION_TYPE, typename MoveSetCallback,
+          typename PromotionSetCallback>
+inline void MoveGenerator::for_each_legal_move_set(const board::Position& position, const CheckInfo& check_info,
+                                                   MoveSetCallback&& move_set_callback,
+                                                   PromotionSetCallback&& promotion_set_callback) const {
   using ActiveColorTraits = board::ColorTraits<ACTIVE_COLOR>;
-  MoveList move_list;
-  const auto occupancy = position.all_pieces<ACTIVE_COLOR>() | position.all_pieces<~ACTIVE_COLOR>();
-  const auto king_coordinate = unsafe_to_coordinate(position.pieces<ACTIVE_COLOR, board::PieceType::KING>());
+  const auto occupancy = position.occupancy();
+  // Pawns split their captures and pushes themselves, and promotions are split by promotion piece type instead.
+  const auto target_mask = GENERATION_TYPE == GenerationType::CAPTURES ? position.all_pieces<~ACTIVE_COLOR>()
+                           : GENERATION_TYPE == GenerationType::QUIETS ? ~occupancy
+                                                                       : ~board::Bitboard();
+  const auto king = position.pieces<ACTIVE_COLOR, board::PieceType::KING>();
+  const auto king_coordinate = unsafe_to_coordinate(king);
+  // The king does not block the sliders attacking it from the squares behind it.
+  const auto kingless_occupancy = occupancy ^ king;
   const auto king_danger_set = [&] {
-    const auto attack_set =
-        [&, active_kingless_occupancy =
-                occupancy & ~position.pieces<ACTIVE_COLOR, board::PieceType::KING>()]<board::PieceType PIECE_TYPE> {
-          board::Bitboard attack_set;
-          board::for_each_coordinate(position.pieces<~ACTIVE_COLOR, PIECE_TYPE>(), [&](const auto origin) {
-            attack_set |= tables_.attack_set<~ACTIVE_COLOR, PIECE_TYPE>(origin, active_kingless_occupancy);
-          });
-          return attack_set;
-        };
+    if (king_danger_ == KingDanger::LAZY) {
+      return board::Bitboard();
+    }
+    const auto attack_set = [&]<board::PieceType PIECE_TYPE> {
+      board::Bitboard attack_set;
+      board::for_each_coordinate(position.pieces<~ACTIVE_COLOR, PIECE_TYPE>(), [&](const auto origin) {
+        attack_set |= tables_.attack_set<~ACTIVE_COLOR, PIECE_TYPE>(origin, kingless_occupancy);
+      });
+      return attack_set;
+    };
     return attack_set.template operator()<board::PieceType::PAWN>() |
            attack_set.template operator()<board::PieceType::KNIGHT>() |
            attack_set.template operator()<board::PieceType::BISHOP>() |
@@ -50,105 +384,134 @@ MoveList MoveGenerator::generate(const board::Position& position) const {
            attack_set.template operator()<board::PieceType::QUEEN>() |
            attack_set.template operator()<board::PieceType::KING>();
   }();
-  const auto king_attacker_set = [&] {
-    const auto attacker_set = [&]<board::PieceType PIECE_TYPE> {
-      return tables_.attack_set<ACTIVE_COLOR, PIECE_TYPE>(king_coordinate, occupancy) &
-             position.pieces<~ACTIVE_COLOR, PIECE_TYPE>();
-    };
-    return attacker_set.template operator()<board::PieceType::PAWN>() |
-           attacker_set.template operator()<board::PieceType::KNIGHT>() |
-           attacker_set.template operator()<board::PieceType::BISHOP>() |
-           attacker_set.template operator()<board::PieceType::ROOK>() |
-           attacker_set.template operator()<board::PieceType::QUEEN>();
-  }();
-  const auto king_attacker_count = king_attacker_set.popcount();
+  // The squares of the set that the king can stand on without being attacked.
+  const auto safe_subset = [&](auto target_set) {
+    if (king_danger_ == KingDanger::EAGER) {
+      return target_set & ~king_danger_set;
+    }
+    for_each_bit(target_set, [&](const auto target) {
+      if (is_attacked<ACTIVE_COLOR>(position, unsafe_to_coordinate(target), kingless_occupancy)) {
+        target_set ^= target;
+      }
+    });
+    return target_set;
+  };
+  const auto king_attacker_count = check_info.checkers.popcount();
   BOOST_ASSERT(king_attacker_count <= 2);
-  for_each_coordinate(
-      pseudo_legal_move_set<ACTIVE_COLOR, board::PieceType::KING>(position, king_coordinate, occupancy) &
-          ~king_danger_set,
-      [&](const auto target) { move_list.emplace_back(king_coordinate, target); });
+  BOOST_ASSERT(GENERATION_TYPE != GenerationType::EVASIONS || king_attacker_count);
+  // Every target in a set is moved to by the same piece from the same origin.
+  const auto from = [](const board::PieceType piece_type, const board::Coordinate origin,
+                       const board::Move::Kind kind = board::Move::Kind::NORMAL) {
+    return [=](const auto target) { return board::Move(piece_type, origin, target, kind); };
+  };
+  move_set_callback(
+      safe_subset(pseudo_legal_move_set<ACTIVE_COLOR, board::PieceType::KING>(position, king_coordinate, occupancy) &
+                  target_mask),
+      from(board::PieceType::KING, king_coordinate));
   if (king_attacker_count == 2) {
-    return move_list;
+    return;
   }
   const auto check_evasion_mask =
-      king_attacker_count ? king_attacker_set | tables_.ray(king_coordinate, unsafe_to_coordinate(king_attacker_set))
-                          : ~board::Bitboard();
-  const auto pinned_move_restriction_masks = [&] {
-    const auto xray_attack_set = [&]<board::PieceType PIECE_TYPE> {
-      const auto attack_set = tables_.attack_set<~ACTIVE_COLOR, PIECE_TYPE>(king_coordinate, occupancy);
-      const auto blockers = position.all_pieces<ACTIVE_COLOR>() & attack_set;
-      return attack_set ^ tables_.attack_set<~ACTIVE_COLOR, PIECE_TYPE>(king_coordinate, occupancy ^ blockers);
-    };
-    const auto pinner_set = (xray_attack_set.template operator()<board::PieceType::BISHOP>() &
-                             position.pieces<~ACTIVE_COLOR, board::PieceType::BISHOP, board::PieceType::QUEEN>()) |
-                            (xray_attack_set.template operator()<board::PieceType::ROOK>() &
-                             position.pieces<~ACTIVE_COLOR, board::PieceType::ROOK, board::PieceType::QUEEN>());
-    auto pinned_move_restriction_masks = board::CoordinateMap<board::Bitboard>::fill(~board::Bitboard());
-    for_each_coordinate(pinner_set, [&](const auto pinner) {
-      const auto ray = tables_.ray(king_coordinate, pinner);
-      pinned_move_restriction_masks[unsafe_to_coordinate(ray & position.all_pieces<ACTIVE_COLOR>())] = ray;
-    });
-    return pinned_move_restriction_masks;
-  }();
+      king_attacker_count
+          ? check_info.checkers | tables_.ray(king_coordinate, unsafe_to_coordinate(check_info.checkers))
+          : ~board::Bitboard();
+  // A pinned piece can only move along the line through its king and its pinner.
+  const auto pin_mask = [&](const auto origin) {
+    return check_info.pinned & board::Bitboard(origin) ? tables_.line(king_coordinate, origin) : ~board::Bitboard();
+  };
   const auto generate_legal_moves = [&]<board::PieceType PIECE_TYPE> {
     static_assert(PIECE_TYPE != board::PieceType::PAWN && PIECE_TYPE != board::PieceType::KING);
     for_each_coordinate(position.pieces<ACTIVE_COLOR, PIECE_TYPE>(), [&](const auto origin) {
-      for_each_coordinate(pseudo_legal_move_set<ACTIVE_COLOR, PIECE_TYPE>(position, origin, occupancy) &
-                              check_evasion_mask & pinned_move_restriction_masks[origin],
-                          [&](const auto target) { move_list.emplace_back(origin, target); });
+      move_set_callback(pseudo_legal_move_set<ACTIVE_COLOR, PIECE_TYPE>(position, origin, occupancy) &
+                            check_evasion_mask & pin_mask(origin) & target_mask,
+                        from(PIECE_TYPE, origin));
     });
   };
   generate_legal_moves.template operator()<board::PieceType::KNIGHT>();
   generate_legal_moves.template operator()<board::PieceType::BISHOP>();
   generate_legal_moves.template operator()<board::PieceType::ROOK>();
   generate_legal_moves.template operator()<board::PieceType::QUEEN>();
-  for_each_bit(position.pieces<ACTIVE_COLOR, board::PieceType::PAWN>(), [&](const auto pawn) {
-    const auto origin = unsafe_to_coordinate(pawn);
-    for_each_coordinate(pseudo_legal_move_set<ACTIVE_COLOR, board::PieceType::PAWN>(position, origin, occupancy) &
-                            check_evasion_mask & pinned_move_restriction_masks[origin],
-                        [&](const auto target) {
-                          if (rank_of(target) == ActiveColorTraits::PAWN_PROMOTION_RANK) {
-                            for (const auto promotion : {board::PieceType::KNIGHT, board::PieceType::BISHOP,
-                                                         board::PieceType::ROOK, board::PieceType::QUEEN}) {
-                              move_list.emplace_back(origin, target, promotion);
-                            }
-                          } else {
-                            move_list.emplace_back(origin, target);
-                          }
-                        });
-    if (const auto en_passant_target = position.en_passant_target(); en_passant_target.has_value()) {
-      board::Bitboard en_passant_target_mask(*en_passant_target);
-      if (tables_.ray(origin, *en_passant_target) == en_passant_target_mask &&
-          rank_of(origin) == ActiveColorTraits::EN_PASSANT_CAPTURE_ORIGIN_RANK) {
-        BOOST_ASSERT(!(occupancy & board::Bitboard(*en_passant_target)));
-        BOOST_ASSERT(rank_of(*en_passant_target) == board::ColorTraits<~ACTIVE_COLOR>::EN_PASSANT_TARGET_RANK);
-        const auto en_passant_target_pawn =
-            board::Bitboard(board::unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(*en_passant_target));
-        BOOST_ASSERT(position.all_pieces<~ACTIVE_COLOR>() & en_passant_target_pawn);
-        const auto occupancy_after_en_passant = (occupancy ^ pawn ^ en_passant_target_pawn) | en_passant_target_mask;
-        if (const auto pinning_bishops_or_queens =
-                tables_.attack_set<~ACTIVE_COLOR, board::PieceType::BISHOP>(king_coordinate,
-                                                                            occupancy_after_en_passant) &
-                position.pieces<~ACTIVE_COLOR, board::PieceType::BISHOP, board::PieceType::QUEEN>();
-            !pinning_bishops_or_queens) {
-          if (const auto pinning_rooks_or_queens =
-                  tables_.attack_set<~ACTIVE_COLOR, board::PieceType::ROOK>(king_coordinate,
-                                                                            occupancy_after_en_passant) &
-                  position.pieces<~ACTIVE_COLOR, board::PieceType::ROOK, board::PieceType::QUEEN>();
-              !pinning_rooks_or_queens) {
-            if (en_passant_target_mask & check_evasion_mask || en_passant_target_pawn & check_evasion_mask) {
-              move_list.emplace_back(origin, *en_passant_target);
-            }
-          }
-        }
-      }
+  const auto generate_pawn_moves = [&](const auto pawns, const auto move_mask) {
+    constexpr auto RELATIVE_NORTH = ActiveColorTraits::RELATIVE_NORTH;
+    constexpr auto RELATIVE_NORTH_EAST = ActiveColorTraits::RELATIVE_NORTH_EAST;
+    constexpr auto RELATIVE_NORTH_WEST = ActiveColorTraits::RELATIVE_NORTH_WEST;
+    // Every target in a set is the same offset away from its origin.
+    const auto from_offset = [](const int offset, const board::Move::Kind kind = board::Move::Kind::NORMAL) {
+      return [=](const auto target) {
+        return board::Move(board::PieceType::PAWN, static_cast<board::Coordinate>(std::to_underlying(target) - offset),
+                           target, kind);
+      };
+    };
+    const auto promotion_rank = board::Bitboard(ActiveColorTraits::PAWN_PROMOTION_RANK);
+    const auto single_push_set = pawns.template shift<RELATIVE_NORTH>() & ~occupancy;
+    const auto double_push_set = single_push_set.template shift<RELATIVE_NORTH>() & ~occupancy &
+                                 board::Bitboard(ActiveColorTraits::PAWN_DOUBLE_PUSH_TARGET_RANK) & move_mask;
+    const auto east_capture_set =
+        pawns.template shift<RELATIVE_NORTH_EAST>() & position.all_pieces<~ACTIVE_COLOR>() & move_mask;
+    const auto west_capture_set =
+        pawns.template shift<RELATIVE_NORTH_WEST>() & position.all_pieces<~ACTIVE_COLOR>() & move_mask;
+    const auto push_set = single_push_set & move_mask;
+    if constexpr (includes_captures(GENERATION_TYPE)) {
+      move_set_callback(east_capture_set & ~promotion_rank, from_offset(std::to_underlying(RELATIVE_NORTH_EAST)));
+      move_set_callback(west_capture_set & ~promotion_rank, from_offset(std::to_underlying(RELATIVE_NORTH_WEST)));
+    }
+    if constexpr (includes_quiets(GENERATION_TYPE)) {
+      move_set_callback(push_set & ~promotion_rank, from_offset(std::to_underlying(RELATIVE_NORTH)));
+      move_set_callback(double_push_set,
+                        from_offset(2 * std::to_underlying(RELATIVE_NORTH), board::Move::Kind::DOUBLE_PUSH));
     }
+    if (pawns & board::Bitboard(ActiveColorTraits::PAWN_PROMOTION_ORIGIN_RANK)) {
+      promotion_set_callback(east_capture_set & promotion_rank, from_offset(std::to_underlying(RELATIVE_NORTH_EAST)));
+      promotion_set_callback(west_capture_set & promotion_rank, from_offset(std::to_underlying(RELATIVE_NORTH_WEST)));
+      promotion_set_callback(push_set & promotion_rank, from_offset(std::to_underlying(RELATIVE_NORTH)));
+    }
+  };
+  // Pinned pawns are rare, so each is generated on its own with the line of its pin as its move mask.
+  const auto pawns = position.pieces<ACTIVE_COLOR, board::PieceType::PAWN>();
+  generate_pawn_moves(pawns & ~check_info.pinned, check_evasion_mask);
+  for_each_bit(pawns & check_info.pinned, [&](const auto pawn) {
+    generate_pawn_moves(pawn, check_evasion_mask & tables_.line(king_coordinate, unsafe_to_coordinate(pawn)));
   });
-  if (king_attacker_count == 0) {
+  if (const auto en_passant_target = position.en_passant_target();
+      includes_captures(GENERATION_TYPE) && en_passant_target.has_value()) {
+    BOOST_ASSERT(!(occupancy & board::Bitboard(*en_passant_target)));
+    BOOST_ASSERT(rank_of(*en_passant_target) == board::ColorTraits<~ACTIVE_COLOR>::EN_PASSANT_TARGET_RANK);
+    const board::Bitboard en_passant_target_mask(*en_passant_target);
+    const auto en_passant_target_pawn =
+        board::Bitboard(board::unsafe_directional_offset<ActiveColorTraits::RELATIVE_SOUTH>(*en_passant_target));
+    BOOST_ASSERT(position.all_pieces<~ACTIVE_COLOR>() & en_passant_target_pawn);
+    // Pins are checked by looking for sliders attacking the king once both pawns have left their squares, which also
+    // covers the pawns pinned along the rank they share.
+    for_each_bit(tables_.attack_set<~ACTIVE_COLOR, board::PieceType::PAWN>(*en_passant_target, occupancy) & pawns,
+                 [&](const auto pawn) {
+                   const auto occupancy_after_en_passant =
+                       (occupancy ^ pawn ^ en_passant_target_pawn) | en_passant_target_mask;
+                   if (tables_.attack_set<~ACTIVE_COLOR, board::PieceType::BISHOP>(king_coordinate,
+                                                                                   occupancy_after_en_passant) &
+                       position.pieces<~ACTIVE_COLOR, board::PieceType::BISHOP, board::PieceType::QUEEN>()) {
+                     return;
+                   }
+                   if (tables_.attack_set<~ACTIVE_COLOR, board::PieceType::ROOK>(king_coordinate,
+                                                                                 occupancy_after_en_passant) &
+                       position.pieces<~ACTIVE_COLOR, board::PieceType::ROOK, board::PieceType::QUEEN>()) {
+                     return;
+                   }
+                   if (en_passant_target_mask & check_evasion_mask || en_passant_target_pawn & check_evasion_mask) {
+                     move_set_callback(en_passant_target_mask, [&](const auto target) {
+                       return board::Move(board::PieceType::PAWN, unsafe_to_coordinate(pawn), target,
+                                          board::Move::Kind::EN_PASSANT)
+                           .with_capture(board::PieceType::PAWN);
+                     });
+                   }
+                 });
+  }
+  if (includes_quiets(GENERATION_TYPE) && king_attacker_count == 0) {
     const auto maybe_generate_castle = [&](const auto king_origin, const auto king_target, const auto rook_origin) {
+      const auto king_path = tables_.ray(king_origin, king_target);
       if ((tables_.ray(king_origin, rook_origin) & occupancy) == board::Bitboard(rook_origin) &&
-          !(king_danger_set & tables_.ray(king_origin, king_target))) {
-        move_list.emplace_back(king_origin, king_target);
+          safe_subset(king_path) == king_path) {
+        move_set_callback(board::Bitboard(king_target),
+                          from(board::PieceType::KING, king_origin, board::Move::Kind::CASTLE));
       }
     };
     if ((position.castling_rights() & ActiveColorTraits::KINGSIDE_CASTLING_RIGHTS) != board::CastlingRights::NONE) {
@@ -160,9 +523,104 @@ MoveList MoveGenerator::generate(const board::Position& position) const {
                             ActiveColorTraits::QUEENSIDE_ROOK_INITIAL_ORIGIN);
     }
   }
+}
+
+template <board::Color ACTIVE_COLOR, GenerationType GENERATION_TYPE, typename MoveCallback>
+inline void MoveGenerator::for_each_legal_move(const board::Position& position, const CheckInfo& check_info,
+                                               MoveCallback&& move_callback) const {
+  const auto empty_set = ~position.occupancy();
+  // Captures are split from each target set by the piece type they capture, which is cheaper per set than looking up
+  // the piece on every target.
+  const auto for_each_move = [&](const auto target_set, const auto move_of, auto&& callback) {
+    for_each_coordinate(target_set & empty_set, [&](const auto target) { callback(move_of(target)); });
+    if (!(target_set & position.all_pieces<~ACTIVE_COLOR>())) {
+      return;
+    }
+    const auto for_each_capture = [&]<board::PieceType CAPTURED> {
+      for_each_coordinate(target_set & position.pieces<~ACTIVE_COLOR, CAPTURED>(),
+                          [&](const auto target) { callback(move_of(target).with_capture(CAPTURED)); });
+    };
+    for_each_capture.template operator()<board::PieceType::PAWN>();
+    for_each_capture.template operator()<board::PieceType::KNIGHT>();
+    for_each_capture.template operator()<board::PieceType::BISHOP>();
+    for_each_capture.template operator()<board::PieceType::ROOK>();
+    for_each_capture.template operator()<board::PieceType::QUEEN>();
+  };
+  for_each_legal_move_set<ACTIVE_COLOR, GENERATION_TYPE>(
+      position, check_info,
+      [&](const auto target_set, const auto move_of) { for_each_move(target_set, move_of, move_callback); },
+      [&](const auto target_set, const auto move_of) {
+        for_each_move(target_set, move_of, [&](const auto move) {
+          if constexpr (includes_quiets(GENERATION_TYPE)) {
+            for (const auto promotion : {board::PieceType::KNIGHT, board::PieceType::BISHOP, board::PieceType::ROOK}) {
+              move_callback(move.with_promotion(promotion));
+            }
+          }
+          if constexpr (includes_captures(GENERATION_TYPE)) {
+            move_callback(move.with_promotion(board::PieceType::QUEEN));
+          }
+        });
+      });
+}
+
+template <board::Color ACTIVE_COLOR, GenerationType GENERATION_TYPE>
+MoveList MoveGenerator::generate(const board::Position& position) const {
+  MoveList move_list;
+  for_each_legal_move<ACTIVE_COLOR, GENERATION_TYPE>(position, checkers_and_pins<ACTIVE_COLOR>(position),
+                                                     [&](const auto move) { move_list.push_back(move); });
   return move_list;
 }
 
-template MoveList MoveGenerator::generate<board::Color::WHITE>(const board::Position&) const;
-template MoveList MoveGenerator::generate<board::Color::BLACK>(const board::Position&) const;
+template <board::Color ACTIVE_COLOR, GenerationType GENERATION_TYPE>
+ScoredMove* MoveGenerator::generate(const board::Position& position, const CheckInfo& check_info,
+                                    ScoredMove* moves) const {
+  for_each_legal_move<ACTIVE_COLOR, GENERATION_TYPE>(position, check_info,
+                                                     [&](const auto move) { *moves++ = {.move = move, .score = 0}; });
+  return moves;
+}
+
+template <board::Color ACTIVE_COLOR, GenerationType GENERATION_TYPE>
+std::size_t MoveGenerator::count(const board::Position& position) const {
+  constexpr auto PROMOTIONS_PER_TARGET = (includes_captures(GENERATION_TYPE) ? 1UZ : 0UZ) +
+                                         (includes_quiets(GENERATION_TYPE) ? 3UZ : 0UZ);
+  auto count = 0UZ;
+  for_each_legal_move_set<ACTIVE_COLOR, GENERATION_TYPE>(
+      position, checkers_and_pins<ACTIVE_COLOR>(position),
+      [&](const auto target_set, const auto) { count += static_cast<std::size_t>(target_set.popcount()); },
+      [&](const auto target_set, const auto) {
+        count += static_cast<std::size_t>(target_set.popcount()) * PROMOTIONS_PER_TARGET;
+      });
+  return count;
+}
+
+#define _(ACTIVE_COLOR)                                                                                              \
+  template CheckInfo MoveGenerator::check_info<board::Color::ACTIVE_COLOR>(const board::Position&) const;            \
+  template bool MoveGenerator::is_pseudo_legal<board::Color::ACTIVE_COLOR>(const board::Position&, const CheckInfo&, \
+                                                                           board::Move) const;                       \
+  template bool MoveGenerator::is_legal<board::Color::ACTIVE_COLOR>(const board::Position&, const CheckInfo&,        \
+                                                                    board::Move) const;                              \
+  template bool MoveGenerator::gives_check<board::Color::ACTIVE_COLOR>(const board::Position&, const CheckInfo&,     \
+                                                                       board::Move) const;                           \
+  template bool MoveGenerator::see_ge<board::Color::ACTIVE_COLOR>(const board::Position&, board::Move,               \
+                                                                  eval::Score) const
+_(WHITE);
+_(BLACK);
+#undef _
+
+#define _(ACTIVE_COLOR, GENERATION_TYPE)                                                                     \
+  template MoveList MoveGenerator::generate<board::Color::ACTIVE_COLOR, GenerationType::GENERATION_TYPE>(    \
+      const board::Position&) const;                                                                         \
+  template ScoredMove* MoveGenerator::generate<board::Color::ACTIVE_COLOR, GenerationType::GENERATION_TYPE>( \
+      const board::Position&, const CheckInfo&, ScoredMove*) const;                                          \
+  template std::size_t MoveGenerator::count<board::Color::ACTIVE_COLOR, GenerationType::GENERATION_TYPE>(    \
+      const board::Position&) const
+_(WHITE, CAPTURES);
+_(WHITE, QUIETS);
+_(WHITE, EVASIONS);
+_(WHITE, ALL);
+_(BLACK, CAPTURES);
+_(BLACK, QUIETS);
+_(BLACK, EVASIONS);
+_(BLACK, ALL);
+#undef _
 }
@@ -1,29 +1,99 @@
 #pragma once
 
+#include <cstddef>
+
 #include "board/bitboard.h"
 #include "board/color.h"
 #include "board/coordinate.h"
 #include "board/piece_type.h"
 #include "board/position.h"
+#include "eval/score.h"
+#include "movegen/check_info.h"
+#include "movegen/generation_type.h"
+#include "movegen/king_danger.h"
 #include "movegen/move_list.h"
+#include "movegen/scored_move.h"
 #include "movegen/tables.h"
 
 namespace prodigy::movegen {
 class MoveGenerator final {
  public:
-  MoveGenerator() = default;
+  explicit MoveGenerator(KingDanger king_danger = KingDanger::LAZY)
+      : tables_(Tables::instance()), king_danger_(king_danger) {}
 
   MoveGenerator(const MoveGenerator&) = delete;
   MoveGenerator& operator=(const MoveGenerator&) = delete;
 
   template <board::Color ACTIVE_COLOR>
+  CheckInfo check_info(const board::Position&) const;
+
+  // Generates legal moves only. Captures and quiets together are exactly all moves, in or out of check.
+  template <board::Color ACTIVE_COLOR, GenerationType = GenerationType::ALL>
   MoveList generate(const board::Position&) const;
 
+  // Writes the same moves in the same order, with zero scores, to a buffer with room for MAX_MOVES. Returns the end of
+  // the moves written. The check info is the one the search already computed for the position.
+  template <board::Color ACTIVE_COLOR, GenerationType = GenerationType::ALL>
+  ScoredMove* generate(const board::Position&, const CheckInfo&, ScoredMove* moves) const;
+
+  // The number of moves generate would return, counted without generating them.
+  template <board::Color ACTIVE_COLOR, GenerationType = GenerationType::ALL>
+  std::size_t count(const board::Position&) const;
+
+  // Together, whether generate would return a move with the same origin, target and promotion, without generating any
+  // moves. Only those are read, so the move can come from the transposition table or from another node, such as a
+  // killer move. is_pseudo_legal checks everything but whether the move leaves the king attacked, which is left to
+  // is_legal and only holds for pseudo-legal moves.
+  template <board::Color ACTIVE_COLOR>
+  bool is_pseudo_legal(const board::Position&, const CheckInfo&, board::Move) const;
+  template <board::Color ACTIVE_COLOR>
+  bool is_legal(const board::Position&, const CheckInfo&, board::Move) const;
+
+  // Whether a legal move, annotated for the position, checks the enemy king.
+  template <board::Color ACTIVE_COLOR>
+  bool gives_check(const board::Position&, const CheckInfo&, board::Move) const;
+
+  // The pieces of both colors attacking the coordinate through the occupancy. Pieces missing from the occupancy are
+  // included too.
+  board::Bitboard attackers_to(const board::Position&, board::Coordinate, board::Bitboard occupancy) const;
+
+  // Static exchange evaluation of an annotated move: whether ACTIVE_COLOR comes out of the exchange on its target at
+  // least the threshold ahead, when each side recaptures with its least valuable attacker or stops when that is better.
+  // Sliders lined up behind an attacker join in once it has captured. Pins are ignored.
+  template <board::Color ACTIVE_COLOR>
+  bool see_ge(const board::Position&, board::Move, eval::Score threshold) const;
+
  private:
+  // The check info without the check squares, which only the search needs.
+  template <board::Color ACTIVE_COLOR>
+  CheckInfo checkers_and_pins(const board::Position&) const;
+
+  // The sliders of SLIDER_COLOR that would attack the king on the coordinate if the blockers that stand alone in their
+  // way were removed.
+  template <board::Color SLIDER_COLOR>
+  board::Bitboard xray_slider_set(const board::Position&, board::Coordinate king_coordinate,
+                                  board::Bitboard blocker_set) const;
+
+  // Whether any enemy of ACTIVE_COLOR attacks the coordinate through the given occupancy.
+  template <board::Color ACTIVE_COLOR>
+  bool is_attacked(const board::Position&, board::Coordinate, board::Bitboard occupancy) const;
+
+  // Calls back with sets of legal targets and a function mapping each target to its move, which is yet to be annotated
+  // with what it captures. Promotions get their own callback, which is responsible for expanding each target into the
+  // promotions included in the generation type.
+  template <board::Color ACTIVE_COLOR, GenerationType, typename MoveSetCallback, typename PromotionSetCallback>
+  void for_each_legal_move_set(const board::Position&, const CheckInfo&, MoveSetCallback&&,
+                               PromotionSetCallback&&) const;
+
+  // Calls back with every legal move, fully annotated.
+  template <board::Color ACTIVE_COLOR, GenerationType, typename MoveCallback>
+  void for_each_legal_move(const board::Position&, const CheckInfo&, MoveCallback&&) const;
+
   template <board::Color, board::PieceType>
   board::Bitboard pseudo_legal_move_set(const board::Position&, board::Coordinate origin,
                                         board::Bitboard occupancy) const;
 
-  const Tables tables_;
+  const Tables& tables_;
+  const KingDanger king_danger_;
 };
 }
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <boost/container/static_vector.hpp>
+#include <cstddef>
 
 #include "board/move.h"
 
 namespace prodigy::movegen {
-using MoveList = boost::container::static_vector<board::Move, 256>;
+// No legal position has more moves than this.
+constexpr auto MAX_MOVES = 256UZ;
+
+using MoveList = boost::container::static_vector<board::Move, MAX_MOVES>;
 }
@@ -1,9 +1,15 @@
 #include "movegen/perft.h"
 
+#include <algorithm>
+#include <boost/assert.hpp>
 #include <ios>
+#include <numeric>
 #include <ostream>
+#include <utility>
 
+#include "base/parallel_for.h"
 #include "board/color.h"
+#include "board/undo.h"
 #include "movegen/move_list.h"
 
 namespace prodigy::movegen {
@@ -12,18 +18,177 @@ template <board::Color ACTIVE_COLOR>
 void perft(const MoveGenerator& move_generator, const board::Position& position,
            std::vector<std::uint64_t>& depth_to_node_count, const Ply depth = 0) {
   ++depth_to_node_count[depth];
-  const auto moves = move_generator.generate<ACTIVE_COLOR>(position);
   if (depth == depth_to_node_count.size() - 2) {
-    depth_to_node_count.back() += moves.size();
+    depth_to_node_count.back() += move_generator.count<ACTIVE_COLOR>(position);
     return;
   }
-  for (const auto move : moves) {
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
     perft<~ACTIVE_COLOR>(move_generator, position.apply<ACTIVE_COLOR>(move), depth_to_node_count, depth + 1);
   }
 }
+
+template <board::Color ACTIVE_COLOR>
+void make_unmake_perft(const MoveGenerator& move_generator, board::Position& position,
+                       std::vector<std::uint64_t>& depth_to_node_count, const Ply depth = 0) {
+  ++depth_to_node_count[depth];
+  if (depth == depth_to_node_count.size() - 2) {
+    depth_to_node_count.back() += move_generator.count<ACTIVE_COLOR>(position);
+    return;
+  }
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+    board::Undo undo;
+    position.make<ACTIVE_COLOR>(move, undo);
+    make_unmake_perft<~ACTIVE_COLOR>(move_generator, position, depth_to_node_count, depth + 1);
+    position.unmake<ACTIVE_COLOR>(move, undo);
+  }
+}
+
+void perft(const MoveGenerator& move_generator, const board::Position& position,
+           std::vector<std::uint64_t>& depth_to_node_count, const PerftStrategy perft_strategy) {
+  switch (perft_strategy) {
+    case PerftStrategy::COPY_MAKE:
+      position.active_color() == board::Color::WHITE
+          ? perft<board::Color::WHITE>(move_generator, position, depth_to_node_count)
+          : perft<board::Color::BLACK>(move_generator, position, depth_to_node_count);
+      break;
+    case PerftStrategy::MAKE_UNMAKE: {
+      auto mutable_position = position;
+      mutable_position.active_color() == board::Color::WHITE
+          ? make_unmake_perft<board::Color::WHITE>(move_generator, mutable_position, depth_to_node_count)
+          : make_unmake_perft<board::Color::BLACK>(move_generator, mutable_position, depth_to_node_count);
+    } break;
+  }
+}
+
+// Counts the nodes above the split ply, and collects the nodes at it in the order a single thread would visit them.
+template <board::Color ACTIVE_COLOR>
+void split(const MoveGenerator& move_generator, const board::Position& position, const Ply split_ply,
+           std::vector<std::uint64_t>& depth_to_node_count, std::vector<board::Position>& work_items,
+           const Ply depth = 0) {
+  if (depth == split_ply) {
+    work_items.push_back(position);
+    return;
+  }
+  ++depth_to_node_count[depth];
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+    split<~ACTIVE_COLOR>(move_generator, position.apply<ACTIVE_COLOR>(move), split_ply, depth_to_node_count,
+                         work_items, depth + 1);
+  }
+}
+
+void parallel_perft(const MoveGenerator& move_generator, const board::Position& position,
+                    std::vector<std::uint64_t>& depth_to_node_count, const PerftStrategy perft_strategy,
+                    const PerftParallelism parallelism) {
+  // The work items must lie above the last ply, which is counted rather than visited.
+  const auto split_ply = std::min<Ply>(parallelism.split_ply, depth_to_node_count.size() - 2);
+  std::vector<board::Position> work_items;
+  position.active_color() == board::Color::WHITE
+      ? split<board::Color::WHITE>(move_generator, position, split_ply, depth_to_node_count, work_items)
+      : split<board::Color::BLACK>(move_generator, position, split_ply, depth_to_node_count, work_items);
+
+  std::vector<std::vector<std::uint64_t>> work_item_to_depth_to_node_count(
+      work_items.size(), std::vector<std::uint64_t>(depth_to_node_count.size() - split_ply));
+  parallel_for(parallelism.thread_count, work_items.size(), [&](const auto work_item) {
+    perft(move_generator, work_items[work_item], work_item_to_depth_to_node_count[work_item], perft_strategy);
+  });
+  // Merged in work item order once every thread has joined, so that the totals never depend on the schedule.
+  for (const auto& work_item_depth_to_node_count : work_item_to_depth_to_node_count) {
+    for (auto i = 0UZ; i < work_item_depth_to_node_count.size(); ++i) {
+      depth_to_node_count[split_ply + i] += work_item_depth_to_node_count[i];
+    }
+  }
 }
 
-PerftResult perft(const MoveGenerator& move_generator, const board::Position& position, const Ply depth) {
+template <board::Color ACTIVE_COLOR>
+std::uint64_t hashed_perft(const MoveGenerator& move_generator, const board::Position& position, const Ply depth,
+                           PerftCache& cache) {
+  if (depth == 1) {
+    return move_generator.count<ACTIVE_COLOR>(position);
+  }
+  if (const auto leaf_count = cache.find(position.hash(), depth); leaf_count.has_value()) {
+    return *leaf_count;
+  }
+  std::uint64_t leaf_count = 0;
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+    if (depth > 2) {
+      cache.prefetch(position.hash_after<ACTIVE_COLOR>(move));
+    }
+    leaf_count += hashed_perft<~ACTIVE_COLOR>(move_generator, position.apply<ACTIVE_COLOR>(move), depth - 1, cache);
+  }
+  cache.store(position.hash(), depth, leaf_count);
+  return leaf_count;
+}
+
+template <board::Color ACTIVE_COLOR>
+std::uint64_t hashed_make_unmake_perft(const MoveGenerator& move_generator, board::Position& position,
+                                       const Ply depth, PerftCache& cache) {
+  if (depth == 1) {
+    return move_generator.count<ACTIVE_COLOR>(position);
+  }
+  if (const auto leaf_count = cache.find(position.hash(), depth); leaf_count.has_value()) {
+    return *leaf_count;
+  }
+  std::uint64_t leaf_count = 0;
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+    if (depth > 2) {
+      cache.prefetch(position.hash_after<ACTIVE_COLOR>(move));
+    }
+    board::Undo undo;
+    position.make<ACTIVE_COLOR>(move, undo);
+    leaf_count += hashed_make_unmake_perft<~ACTIVE_COLOR>(move_generator, position, depth - 1, cache);
+    position.unmake<ACTIVE_COLOR>(move, undo);
+  }
+  cache.store(position.hash(), depth, leaf_count);
+  return leaf_count;
+}
+
+std::uint64_t hashed_perft(const MoveGenerator& move_generator, const board::Position& position, const Ply depth,
+                           const PerftStrategy perft_strategy, PerftCache& cache) {
+  switch (perft_strategy) {
+    case PerftStrategy::COPY_MAKE:
+      return position.active_color() == board::Color::WHITE
+                 ? hashed_perft<board::Color::WHITE>(move_generator, position, depth, cache)
+                 : hashed_perft<board::Color::BLACK>(move_generator, position, depth, cache);
+    case PerftStrategy::MAKE_UNMAKE: {
+      auto mutable_position = position;
+      return mutable_position.active_color() == board::Color::WHITE
+                 ? hashed_make_unmake_perft<board::Color::WHITE>(move_generator, mutable_position, depth, cache)
+                 : hashed_make_unmake_perft<board::Color::BLACK>(move_generator, mutable_position, depth, cache);
+    }
+  }
+  __builtin_unreachable();
+}
+
+// The cache only remembers the leaves below each node, so every depth is counted by a walk of its own. The shallower
+// walks are cheap, and fill the cache for the deeper ones.
+void hashed_perft(const MoveGenerator& move_generator, const board::Position& position,
+                  std::vector<std::uint64_t>& depth_to_node_count, const PerftStrategy perft_strategy,
+                  const PerftParallelism parallelism, PerftCache& cache) {
+  depth_to_node_count.front() = 1;
+  for (auto depth = 1UZ; depth < depth_to_node_count.size(); ++depth) {
+    if (parallelism.thread_count == 1) {
+      depth_to_node_count[depth] = hashed_perft(move_generator, position, depth, perft_strategy, cache);
+      continue;
+    }
+    const auto split_ply = std::min<Ply>(parallelism.split_ply, depth - 1);
+    std::vector<std::uint64_t> split_depth_to_node_count(depth + 1);
+    std::vector<board::Position> work_items;
+    position.active_color() == board::Color::WHITE
+        ? split<board::Color::WHITE>(move_generator, position, split_ply, split_depth_to_node_count, work_items)
+        : split<board::Color::BLACK>(move_generator, position, split_ply, split_depth_to_node_count, work_items);
+    std::vector<std::uint64_t> work_item_to_leaf_count(work_items.size());
+    parallel_for(parallelism.thread_count, work_items.size(), [&](const auto work_item) {
+      work_item_to_leaf_count[work_item] =
+          hashed_perft(move_generator, work_items[work_item], depth - split_ply, perft_strategy, cache);
+    });
+    depth_to_node_count[depth] = std::reduce(work_item_to_leaf_count.begin(), work_item_to_leaf_count.end());
+  }
+}
+}
+
+PerftResult perft(const MoveGenerator& move_generator, const board::Position& position, const Ply depth,
+                  const PerftStrategy perft_strategy, const PerftParallelism parallelism, PerftCache* const cache) {
+  BOOST_ASSERT(parallelism.thread_count > 0);
   PerftResult result{};
   if (depth == 0) {
     result.depth_to_node_count.push_back(1);
@@ -31,13 +196,35 @@ PerftResult perft(const MoveGenerator& move_generator, const board::Position& po
   }
   result.depth_to_node_count.resize(depth + 1);
   const auto start_time = std::chrono::steady_clock::now();
-  position.active_color() == board::Color::WHITE
-      ? perft<board::Color::WHITE>(move_generator, position, result.depth_to_node_count)
-      : perft<board::Color::BLACK>(move_generator, position, result.depth_to_node_count);
+  if (cache != nullptr) {
+    hashed_perft(move_generator, position, result.depth_to_node_count, perft_strategy, parallelism, *cache);
+  } else if (parallelism.thread_count == 1) {
+    perft(move_generator, position, result.depth_to_node_count, perft_strategy);
+  } else {
+    parallel_perft(move_generator, position, result.depth_to_node_count, perft_strategy, parallelism);
+  }
   result.runtime = std::chrono::duration_cast<decltype(result.runtime)>(std::chrono::steady_clock::now() - start_time);
   return result;
 }
 
+std::vector<std::pair<board::Move, std::uint64_t>> divide(const MoveGenerator& move_generator,
+                                                          const board::Position& position, const Ply depth,
+                                                          const PerftStrategy perft_strategy,
+                                                          const PerftParallelism parallelism, PerftCache* const cache) {
+  BOOST_ASSERT(depth > 0);
+  std::vector<std::pair<board::Move, std::uint64_t>> move_to_leaf_count;
+  const auto divide = [&]<board::Color ACTIVE_COLOR> {
+    for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+      const auto result = perft(move_generator, position.apply<ACTIVE_COLOR>(move), depth - 1, perft_strategy,
+                                parallelism, cache);
+      move_to_leaf_count.emplace_back(move, result.depth_to_node_count.back());
+    }
+  };
+  position.active_color() == board::Color::WHITE ? divide.template operator()<board::Color::WHITE>()
+                                                 : divide.template operator()<board::Color::BLACK>();
+  return move_to_leaf_count;
+}
+
 std::ostream& operator<<(std::ostream& os, const PerftResult& result) {
   for (auto i = 0UZ; i < result.depth_to_node_count.size(); ++i) {
     os << " perft(" << i << "): " << result.depth_to_node_count[i] << '\n';
@@ -3,19 +3,44 @@
 #include <chrono>
 #include <cstdint>
 #include <iosfwd>
+#include <utility>
 #include <vector>
 
 #include "base/ply.h"
+#include "board/move.h"
 #include "board/position.h"
 #include "movegen/move_generator.h"
+#include "movegen/perft_cache.h"
 
 namespace prodigy::movegen {
+// How perft walks from a position to its children.
+enum class PerftStrategy : std::uint8_t {
+  // Applies each move to a copy of the position.
+  COPY_MAKE,
+  // Makes and unmakes each move on a single position.
+  MAKE_UNMAKE,
+};
+
+// How perft spreads the tree over threads. Every node at the split ply becomes a work item, and the threads take work
+// items in turn until none are left.
+struct PerftParallelism final {
+  unsigned thread_count = 1;
+  Ply split_ply = 2;
+};
+
 struct PerftResult final {
   std::chrono::microseconds runtime;
   std::vector<std::uint64_t> depth_to_node_count;
 };
 
-PerftResult perft(const MoveGenerator&, const board::Position&, Ply depth);
+// Looks up and stores the leaves below each interior node in the cache, if there is one.
+PerftResult perft(const MoveGenerator&, const board::Position&, Ply depth,
+                  PerftStrategy = PerftStrategy::COPY_MAKE, PerftParallelism = {}, PerftCache* = nullptr);
+
+// Counts the leaves below each root move separately, in the order they are generated.
+std::vector<std::pair<board::Move, std::uint64_t>> divide(const MoveGenerator&, const board::Position&, Ply depth,
+                                                          PerftStrategy = PerftStrategy::COPY_MAKE,
+                                                          PerftParallelism = {}, PerftCache* = nullptr);
 
 std::ostream& operator<<(std::ostream&, const PerftResult&);
 }
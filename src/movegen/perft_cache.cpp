@@ -0,0 +1,28 @@
+#include "movegen/perft_cache.h"
+
+#include <boost/assert.hpp>
+
+namespace prodigy::movegen {
+PerftCache::PerftCache(const std::size_t megabytes) : entries_(megabytes * (1 << 20) / sizeof(Entry)) {
+  BOOST_ASSERT(!entries_.empty());
+}
+
+void PerftCache::prefetch(const zobrist::Hash hash) const { __builtin_prefetch(&entries_[hash % entries_.size()]); }
+
+std::optional<std::uint64_t> PerftCache::find(const zobrist::Hash hash, const Ply depth) const {
+  const auto& entry = entries_[hash % entries_.size()];
+  const auto data = entry.data.load(std::memory_order_relaxed);
+  if ((entry.hash_xor_data.load(std::memory_order_relaxed) ^ data) != hash || data >> DEPTH_SHIFT != depth) {
+    return std::nullopt;
+  }
+  return data & ((std::uint64_t{1} << DEPTH_SHIFT) - 1);
+}
+
+void PerftCache::store(const zobrist::Hash hash, const Ply depth, const std::uint64_t leaf_count) {
+  BOOST_ASSERT(leaf_count >> DEPTH_SHIFT == 0);
+  auto& entry = entries_[hash % entries_.size()];
+  const auto data = std::uint64_t{depth} << DEPTH_SHIFT | leaf_count;
+  entry.hash_xor_data.store(hash ^ data, std::memory_order_relaxed);
+  entry.data.store(data, std::memory_order_relaxed);
+}
+}
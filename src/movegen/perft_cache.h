@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "base/ply.h"
+#include "zobrist/hash.h"
+
+namespace prodigy::movegen {
+// Maps a position and the depth left below it to the number of leaves under it. Safe to share between perft threads
+// without locks: each entry stores its hash XORed with its data, so an entry torn by concurrent stores fails to verify
+// and reads as a miss.
+class PerftCache final {
+ public:
+  explicit PerftCache(std::size_t megabytes);
+
+  PerftCache(const PerftCache&) = delete;
+  PerftCache& operator=(const PerftCache&) = delete;
+
+  // Starts loading the entry for the hash into cache, so that a later find does not stall on memory.
+  void prefetch(zobrist::Hash) const;
+  std::optional<std::uint64_t> find(zobrist::Hash, Ply depth) const;
+  void store(zobrist::Hash, Ply depth, std::uint64_t leaf_count);
+
+ private:
+  // The depth lives above the leaf count, which leaves room for counts up to 2^56.
+  static constexpr auto DEPTH_SHIFT = 56;
+
+  struct Entry final {
+    std::atomic<zobrist::Hash> hash_xor_data;
+    std::atomic<std::uint64_t> data;
+  };
+
+  std::vector<Entry> entries_;
+};
+}
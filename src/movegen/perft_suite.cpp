@@ -0,0 +1,132 @@
+#include "movegen/perft_suite.h"
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <chrono>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "base/parallel_for.h"
+#include "base/string_utils.h"
+#include "movegen/perft.h"
+
+namespace prodigy::movegen {
+namespace {
+struct Report final {
+  // Whether any depth of the entry is within the maximum, and so checked.
+  bool is_checked = false;
+  std::optional<std::pair<Ply, std::uint64_t>> mismatch;
+  std::uint64_t leaf_count = 0;
+};
+}
+
+std::optional<PerftSuiteEntry> parse_perft_suite_entry(const std::string_view line) {
+  const auto fields = split(line, ";");
+  if (fields.empty()) {
+    return std::nullopt;
+  }
+  std::string fen(fields.front());
+  switch (split(fen).size()) {
+    case 4:
+      fen += " 0 1";
+      break;
+    case 6:
+      break;
+    default:
+      return std::nullopt;
+  }
+  if (!board::Position::is_valid_fen(fen) || fields.size() == 1) {
+    return std::nullopt;
+  }
+  PerftSuiteEntry entry{.position = board::Position::from_fen(fen), .depth_to_leaf_count = {}};
+  for (auto i = 1UZ; i < fields.size(); ++i) {
+    const auto tokens = split(fields[i]);
+    if (tokens.size() != 2 || tokens.front().size() < 2 || tokens.front().front() != 'D') {
+      return std::nullopt;
+    }
+    const auto depth = to_arithmetic<Ply>(tokens.front().substr(1));
+    const auto leaf_count = to_arithmetic<std::uint64_t>(tokens.back());
+    if (!depth.has_value() || *depth == 0 || *depth > MAX_PLY || !leaf_count.has_value()) {
+      return std::nullopt;
+    }
+    entry.depth_to_leaf_count.emplace_back(*depth, *leaf_count);
+  }
+  return entry;
+}
+
+bool run_perft_suite(const MoveGenerator& move_generator, std::istream& is, std::ostream& os,
+                     const unsigned thread_count, const Ply max_depth, PerftCache* const cache) {
+  BOOST_ASSERT(thread_count > 0);
+  std::vector<std::string> lines;
+  // Nullopt for the lines that cannot be parsed, which are reported along with the others in file order.
+  std::vector<std::optional<PerftSuiteEntry>> entries;
+  for (std::string line; std::getline(is, line);) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    entries.push_back(parse_perft_suite_entry(line));
+    lines.push_back(std::move(line));
+  }
+
+  std::vector<Report> reports(entries.size());
+  const auto start_time = std::chrono::steady_clock::now();
+  parallel_for(thread_count, entries.size(), [&](const auto i) {
+    if (!entries[i].has_value()) {
+      return;
+    }
+    const auto& [position, depth_to_leaf_count] = *entries[i];
+    Ply depth = 0;
+    for (const auto& [expected_depth, expected_leaf_count] : depth_to_leaf_count) {
+      if (expected_depth <= max_depth) {
+        depth = std::max(depth, expected_depth);
+      }
+    }
+    if (depth == 0) {
+      return;
+    }
+    const auto result = perft(move_generator, position, depth, PerftStrategy::COPY_MAKE, {}, cache);
+    auto& report = reports[i];
+    report.is_checked = true;
+    report.leaf_count = result.depth_to_node_count.back();
+    for (const auto& [expected_depth, expected_leaf_count] : depth_to_leaf_count) {
+      if (expected_depth <= max_depth && result.depth_to_node_count[expected_depth] != expected_leaf_count) {
+        report.mismatch.emplace(expected_depth, result.depth_to_node_count[expected_depth]);
+        break;
+      }
+    }
+  });
+  const std::chrono::duration<double> runtime = std::chrono::steady_clock::now() - start_time;
+
+  auto all_passed = true;
+  auto passed_count = 0UZ;
+  auto skipped_count = 0UZ;
+  std::uint64_t leaf_count = 0;
+  for (auto i = 0UZ; i < entries.size(); ++i) {
+    const auto& report = reports[i];
+    leaf_count += report.leaf_count;
+    if (!entries[i].has_value()) {
+      ++skipped_count;
+      all_passed = false;
+      os << "  SKIP  " << lines[i] << ": cannot parse\n";
+    } else if (!report.is_checked) {
+      ++skipped_count;
+      os << "  SKIP  " << lines[i] << ": no depth <= " << +max_depth << '\n';
+    } else if (report.mismatch.has_value()) {
+      all_passed = false;
+      const auto [depth, actual_leaf_count] = *report.mismatch;
+      os << "  FAIL  " << lines[i] << ": D" << +depth << " counted " << actual_leaf_count << '\n';
+    } else {
+      ++passed_count;
+      os << "  PASS  " << lines[i] << '\n';
+    }
+  }
+  os << "\n   Passed: " << passed_count << '/' << entries.size() << '\n';
+  os << "  Skipped: " << skipped_count << '\n';
+  os << "    Nodes: " << leaf_count << '\n';
+  os << "      NPS: " << std::fixed << leaf_count / runtime.count() << '\n';
+  os << "  Runtime: " << runtime.count() << "s\n";
+  return all_passed;
+}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/position.h"
+#include "movegen/move_generator.h"
+#include "movegen/perft_cache.h"
+
+namespace prodigy::movegen {
+// A position of a perft suite, and the leaf counts expected at some of the depths below it.
+struct PerftSuiteEntry final {
+  board::Position position;
+  std::vector<std::pair<Ply, std::uint64_t>> depth_to_leaf_count;
+};
+
+// Parses a line of a perftsuite-style EPD file, such as "<FEN> ;D1 20 ;D2 400". The halfmove clock and fullmove number
+// may be left out of the FEN. Returns nullopt if the line is malformed, including when the FEN is invalid or there are
+// no depths to check.
+std::optional<PerftSuiteEntry> parse_perft_suite_entry(std::string_view line);
+
+// Checks every entry of the suite read from the input up to the maximum depth, one entry per thread at a time. Reports
+// each line in file order and then the totals to the output. Lines that cannot be parsed, and entries with no depth up
+// to the maximum, are skipped. Returns whether every line could be parsed and no entry failed.
+bool run_perft_suite(const MoveGenerator&, std::istream&, std::ostream&, unsigned thread_count, Ply max_depth = MAX_PLY,
+                     PerftCache* = nullptr);
+}
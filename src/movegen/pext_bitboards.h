@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <boost/assert.hpp>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "board/bitboard.h"
+#include "board/coordinate.h"
+#include "board/coordinate_map.h"
+#include "movegen/bit_manipulation.h"
+
+namespace prodigy::movegen {
+// Like MagicBitboards, but indexed by extracting the masked occupancy bits with PEXT instead of a multiply and shift.
+template <std::size_t ATTACK_TABLE_SIZE>
+class PextBitboards final {
+ public:
+  template <std::predicate<board::Coordinate, board::Coordinate> MaskContains,
+            std::invocable<board::Coordinate, board::Bitboard> AttackSet>
+  constexpr PextBitboards(MaskContains&& mask_contains, AttackSet&& attack_set)
+      : origin_to_record_([&] {
+          board::CoordinateMap<Record> origin_to_record;
+          std::uint32_t offset = 0;
+          board::for_each_coordinate([&](const auto origin) {
+            auto& [mask, record_offset] = origin_to_record[origin];
+            board::for_each_coordinate([&](const auto target) {
+              if (target != origin && std::forward<MaskContains>(mask_contains)(origin, target)) {
+                mask |= board::Bitboard(target);
+              }
+            });
+            record_offset = offset;
+            offset += 1U << mask.popcount();
+          });
+          BOOST_ASSERT(offset == ATTACK_TABLE_SIZE);
+          return origin_to_record;
+        }()),
+        attack_table_([&] {
+          std::array<board::Bitboard, ATTACK_TABLE_SIZE> attack_table;
+          board::for_each_coordinate([&](const auto origin) {
+            const auto& [mask, offset] = origin_to_record_[origin];
+            // Subsets of the mask are enumerated in the order of their PEXT indices.
+            auto index = offset;
+            auto occupancy = board::Bitboard();
+            do {
+              attack_table[index++] = std::forward<AttackSet>(attack_set)(origin, occupancy);
+              occupancy = occupancy.next_subset(mask);
+            } while (occupancy);
+          });
+          return attack_table;
+        }()) {}
+
+  PextBitboards(const PextBitboards&) = delete;
+  PextBitboards& operator=(const PextBitboards&) = delete;
+
+  board::Bitboard attack_set(const board::Coordinate origin, const board::Bitboard occupancy) const {
+    const auto& [mask, offset] = origin_to_record_[origin];
+    return attack_table_[offset + pext(occupancy.underlying(), mask.underlying())];
+  }
+
+ private:
+  struct Record {
+    board::Bitboard mask;
+    std::uint32_t offset;
+  };
+
+  const board::CoordinateMap<Record> origin_to_record_;
+  const std::array<board::Bitboard, ATTACK_TABLE_SIZE> attack_table_;
+};
+}
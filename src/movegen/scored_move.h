@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+#include "board/move.h"
+
+namespace prodigy::movegen {
+struct ScoredMove final {
+  board::Move move;
+  std::int32_t score;
+};
+}
@@ -0,0 +1,35 @@
+#include "movegen/slider_backend.h"
+
+#include <ostream>
+
+namespace prodigy::movegen {
+bool is_supported(const SliderBackend slider_backend) {
+  switch (slider_backend) {
+    case SliderBackend::MAGIC:
+    case SliderBackend::HYPERBOLA_QUINTESSENCE:
+      return true;
+    case SliderBackend::PEXT:
+#ifdef PRODIGY_PEXT
+      return __builtin_cpu_supports("bmi2");
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+std::ostream& operator<<(std::ostream& os, const SliderBackend slider_backend) {
+  switch (slider_backend) {
+    case SliderBackend::MAGIC:
+      os << "magic";
+      break;
+    case SliderBackend::PEXT:
+      os << "pext";
+      break;
+    case SliderBackend::HYPERBOLA_QUINTESSENCE:
+      os << "hyperbola";
+      break;
+  }
+  return os;
+}
+}
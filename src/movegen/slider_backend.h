@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+
+namespace prodigy::movegen {
+enum class SliderBackend : std::uint8_t {
+  MAGIC,
+  PEXT,
+  HYPERBOLA_QUINTESSENCE,
+};
+
+inline constexpr std::array SLIDER_BACKENDS = {
+    SliderBackend::MAGIC,
+    SliderBackend::PEXT,
+    SliderBackend::HYPERBOLA_QUINTESSENCE,
+};
+
+constexpr std::optional<SliderBackend> to_slider_backend(const std::string_view slider_backend) {
+  if (slider_backend == "magic") {
+    return SliderBackend::MAGIC;
+  }
+  if (slider_backend == "pext") {
+    return SliderBackend::PEXT;
+  }
+  if (slider_backend == "hyperbola") {
+    return SliderBackend::HYPERBOLA_QUINTESSENCE;
+  }
+  return std::nullopt;
+}
+
+// The backend that every attack set lookup goes through, fixed at build time by PRODIGY_SLIDER_BACKEND. Left to the
+// build, it is PEXT when the build targets BMI2, except when it is tuned for AMD family 17h (Zen 1 and Zen 2), which
+// microcodes PEXT so that magic bitboards are faster. Otherwise it is magic bitboards.
+inline constexpr SliderBackend SLIDER_BACKEND = [] {
+#ifdef PRODIGY_SLIDER_BACKEND
+  constexpr auto slider_backend = to_slider_backend(PRODIGY_SLIDER_BACKEND);
+  static_assert(slider_backend.has_value());
+  return *slider_backend;
+#elif defined(PRODIGY_PEXT) && defined(__BMI2__) && !defined(__znver1__) && !defined(__znver2__)
+  return SliderBackend::PEXT;
+#else
+  return SliderBackend::MAGIC;
+#endif
+}();
+
+// Whether the backend is compiled in and the running CPU can run it.
+bool is_supported(SliderBackend);
+
+std::ostream& operator<<(std::ostream&, SliderBackend);
+}
@@ -1,5 +1,8 @@
 #include "movegen/tables.h"
 
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <concepts>
 #include <utility>
 
@@ -23,21 +26,41 @@ constexpr board::Bitboard adjacent_attack_set(const board::Coordinate origin) {
   return (attack_set(board::directional_offset<DIRECTIONS>(origin)) | ...);
 }
 
-template <board::Direction DIRECTION, board::Direction... DIRECTIONS>
-constexpr board::Bitboard sliding_attack_set(const board::Coordinate origin, const board::Bitboard occupancy) {
-  if constexpr (!sizeof...(DIRECTIONS)) {
-    board::Bitboard attack_set;
+// Slider attack sets are evaluated once per occupancy subset while the slider tables are constant evaluated, so they
+// stick to plain integer arithmetic, which the compiler evaluates far more cheaply than Bitboard operations.
+template <board::Direction DIRECTION>
+constexpr auto DIRECTIONAL_RAY_TABLE = [] {
+  struct {
+    std::uint64_t rays[64];
+  } ray_table{};
+  board::for_each_coordinate([&](const auto origin) {
+    board::Bitboard ray;
     for (auto target = board::directional_offset<DIRECTION>(origin); target.has_value();
          target = board::directional_offset<DIRECTION>(*target)) {
-      attack_set |= board::Bitboard(*target);
-      if (occupancy & board::Bitboard(*target)) {
-        break;
-      }
+      ray |= board::Bitboard(*target);
     }
-    return attack_set;
-  } else {
-    return sliding_attack_set<DIRECTION>(origin, occupancy) | sliding_attack_set<DIRECTIONS...>(origin, occupancy);
+    ray_table.rays[std::to_underlying(origin)] = ray.underlying();
+  });
+  return ray_table;
+}();
+
+template <board::Direction DIRECTION>
+constexpr std::uint64_t directional_attack_set(const std::uint8_t origin, const std::uint64_t occupancy) {
+  auto attack_set = DIRECTIONAL_RAY_TABLE<DIRECTION>.rays[origin];
+  if (const auto blockers = attack_set & occupancy) {
+    // The blocker nearest to the origin shadows the rest of the ray.
+    attack_set ^= DIRECTIONAL_RAY_TABLE<DIRECTION>.rays[std::to_underlying(DIRECTION) > 0
+                                                            ? std::countr_zero(blockers)
+                                                            : 63 - std::countl_zero(blockers)];
   }
+  return attack_set;
+}
+
+template <board::Direction... DIRECTIONS>
+constexpr board::Bitboard sliding_attack_set(const board::Coordinate origin, const board::Bitboard occupancy) {
+  const auto origin_index = static_cast<std::uint8_t>(origin);
+  const auto blockers = occupancy.underlying();
+  return std::bit_cast<board::Bitboard>((directional_attack_set<DIRECTIONS>(origin_index, blockers) | ...));
 }
 
 constexpr bool same_diagonal_or_antidiagonal(const board::Coordinate origin, const board::Coordinate target) {
@@ -49,74 +72,156 @@ constexpr bool same_diagonal_or_antidiagonal(const board::Coordinate origin, con
   };
   return diagonal(origin) == diagonal(target) || anti_diagonal(origin) == anti_diagonal(target);
 }
+
+constexpr bool bishop_mask_contains(const board::Coordinate origin, const board::Coordinate target) {
+  if (file_of(target) == board::File::A || file_of(target) == board::File::H || rank_of(target) == board::Rank::ONE ||
+      rank_of(target) == board::Rank::EIGHT) {
+    return false;
+  }
+  return same_diagonal_or_antidiagonal(origin, target);
+}
+
+constexpr bool rook_mask_contains(const board::Coordinate origin, const board::Coordinate target) {
+  if (file_of(origin) == file_of(target)) {
+    return rank_of(target) != board::Rank::ONE && rank_of(target) != board::Rank::EIGHT;
+  }
+  if (rank_of(origin) == rank_of(target)) {
+    return file_of(target) != board::File::A && file_of(target) != board::File::H;
+  }
+  return false;
 }
 
-Tables::Tables()
-    : white_pawn_attack_table_(
-          non_sliding_attack_table(adjacent_attack_set<board::Direction::NORTH_EAST, board::Direction::NORTH_WEST>)),
-      black_pawn_attack_table_(
-          non_sliding_attack_table(adjacent_attack_set<board::Direction::SOUTH_EAST, board::Direction::SOUTH_WEST>)),
-      knight_attack_table_(non_sliding_attack_table([](const auto origin) {
-        board::Bitboard attack_set;
-        if (const auto target = board::directional_offset<board::Direction::NORTH_EAST>(origin); target.has_value()) {
-          attack_set |= adjacent_attack_set<board::Direction::NORTH, board::Direction::EAST>(*target);
-        }
-        if (const auto target = board::directional_offset<board::Direction::SOUTH_EAST>(origin); target.has_value()) {
-          attack_set |= adjacent_attack_set<board::Direction::SOUTH, board::Direction::EAST>(*target);
-        }
-        if (const auto target = board::directional_offset<board::Direction::SOUTH_WEST>(origin); target.has_value()) {
-          attack_set |= adjacent_attack_set<board::Direction::SOUTH, board::Direction::WEST>(*target);
-        }
-        if (const auto target = board::directional_offset<board::Direction::NORTH_WEST>(origin); target.has_value()) {
-          attack_set |= adjacent_attack_set<board::Direction::NORTH, board::Direction::WEST>(*target);
-        }
-        return attack_set;
-      })),
-      king_attack_table_(non_sliding_attack_table(
-          adjacent_attack_set<board::Direction::NORTH, board::Direction::NORTH_EAST, board::Direction::EAST,
-                              board::Direction::SOUTH_EAST, board::Direction::SOUTH, board::Direction::SOUTH_WEST,
-                              board::Direction::WEST, board::Direction::NORTH_WEST>)),
-      bishop_magic_bitboards_(
-          [](const auto origin, const auto target) {
-            if (file_of(target) == board::File::A || file_of(target) == board::File::H ||
-                rank_of(target) == board::Rank::ONE || rank_of(target) == board::Rank::EIGHT) {
-              return false;
-            }
-            return same_diagonal_or_antidiagonal(origin, target);
-          },
-          sliding_attack_set<board::Direction::NORTH_EAST, board::Direction::SOUTH_EAST, board::Direction::SOUTH_WEST,
-                             board::Direction::NORTH_WEST>),
-      rook_magic_bitboards_(
-          [](const auto origin, const auto target) {
-            if (file_of(origin) == file_of(target)) {
-              return rank_of(target) != board::Rank::ONE && rank_of(target) != board::Rank::EIGHT;
-            }
-            if (rank_of(origin) == rank_of(target)) {
-              return file_of(target) != board::File::A && file_of(target) != board::File::H;
-            }
-            return false;
-          },
-          sliding_attack_set<board::Direction::NORTH, board::Direction::EAST, board::Direction::SOUTH,
-                             board::Direction::WEST>),
-      ray_table_([&] {
-        board::CoordinateMap<board::CoordinateMap<board::Bitboard>> ray_table;
-        board::for_each_coordinate([&](const auto origin) {
-          board::for_each_coordinate([&](const auto target) {
-            if (file_of(origin) == file_of(target) || rank_of(origin) == rank_of(target)) {
-              ray_table[origin][target] = (rook_magic_bitboards_.attack_set(origin, board::Bitboard(target)) &
-                                           rook_magic_bitboards_.attack_set(target, board::Bitboard(origin))) |
-                                          board::Bitboard(target);
-            } else if (same_diagonal_or_antidiagonal(origin, target)) {
-              ray_table[origin][target] = (bishop_magic_bitboards_.attack_set(origin, board::Bitboard(target)) &
-                                           bishop_magic_bitboards_.attack_set(target, board::Bitboard(origin))) |
-                                          board::Bitboard(target);
-            }
+constexpr auto bishop_attack_set = sliding_attack_set<board::Direction::NORTH_EAST, board::Direction::SOUTH_EAST,
+                                                      board::Direction::SOUTH_WEST, board::Direction::NORTH_WEST>;
+constexpr auto rook_attack_set = sliding_attack_set<board::Direction::NORTH, board::Direction::EAST,
+                                                    board::Direction::SOUTH, board::Direction::WEST>;
+
+constexpr board::Bitboard knight_attack_set(const board::Coordinate origin) {
+  board::Bitboard attack_set;
+  if (const auto target = board::directional_offset<board::Direction::NORTH_EAST>(origin); target.has_value()) {
+    attack_set |= adjacent_attack_set<board::Direction::NORTH, board::Direction::EAST>(*target);
+  }
+  if (const auto target = board::directional_offset<board::Direction::SOUTH_EAST>(origin); target.has_value()) {
+    attack_set |= adjacent_attack_set<board::Direction::SOUTH, board::Direction::EAST>(*target);
+  }
+  if (const auto target = board::directional_offset<board::Direction::SOUTH_WEST>(origin); target.has_value()) {
+    attack_set |= adjacent_attack_set<board::Direction::SOUTH, board::Direction::WEST>(*target);
+  }
+  if (const auto target = board::directional_offset<board::Direction::NORTH_WEST>(origin); target.has_value()) {
+    attack_set |= adjacent_attack_set<board::Direction::NORTH, board::Direction::WEST>(*target);
+  }
+  return attack_set;
+}
+
+// Found offline with the usual trial-and-error search for sparse magics which map every occupancy subset of the
+// mask to a constructive collision, using a shift of 64 - popcount(mask).
+constexpr std::array<Magic, 64> BISHOP_MAGICS = {
+    0x0020015210890200, 0x0005010801050040, 0x1088008406910412, 0x0468049106182004,
+    0xA002021001000120, 0x1B02082208204000, 0x0024010110116012, 0x1000840082012080,
+    0x1032400812440048, 0x0000D805842400C0, 0x21000820A1220010, 0x008004410120040C,
+    0xA000440420000204, 0x2200884808440000, 0xC002060802080500, 0x0A08104104212080,
+    0x0008204008C10400, 0x0090020210110110, 0x0020406202040024, 0x001A002020244203,
+    0x0002040C020A0100, 0x0200C00881602000, 0x0001100403091106, 0x0001024020880420,
+    0x0842401811050810, 0x0818190004104180, 0x0082080001005400, 0x0704080000202040,
+    0x0001080405004004, 0x0004004008080200, 0x2404014005080641, 0x8C08420820821100,
+    0xD090180448083108, 0x0004020242089040, 0x0184020811010041, 0x8003200801010104,
+    0x0090008200022200, 0x2448810100021000, 0x4081890200040220, 0x4100820088C20081,
+    0x003208200A018400, 0x8025282110008400, 0x4000101088009000, 0x0020822018000107,
+    0x0010400092039501, 0x9C0841080E001288, 0x9004510204000212, 0x2082820401050022,
+    0x012A00B228401000, 0x0C00410C01602000, 0x0040004200902010, 0x0400004884040118,
+    0x0582024008220008, 0x0800A14202820000, 0x0010100101041000, 0x1820088100408007,
+    0x0A02120510080401, 0xCA91004202100203, 0x8824001831080800, 0x0A04150400841105,
+    0x3020620288102400, 0x102102A002028200, 0x4001842002A40108, 0x00101110040D8020,
+};
+
+constexpr std::array<Magic, 64> ROOK_MAGICS = {
+    0x1080002040008010, 0x2840001000200043, 0x8900100C20004100, 0x0600041042008820,
+    0x0280240080080002, 0x1A00044130020008, 0x0080020000800100, 0x208000224C800100,
+    0x0010802040008001, 0x0004400040201000, 0x0080808010002000, 0x0220800800100080,
+    0x0002001006002008, 0x0200800200040080, 0x000C008410422108, 0x0001000080410002,
+    0x0000248000400482, 0x0010084000200040, 0x0010002020040800, 0x4030028008008054,
+    0x84C0808004000801, 0x1808080110200440, 0x1000040081021008, 0x0000020000610084,
+    0x0200802180004000, 0x9000520200210080, 0x0800100080802000, 0x0120250900100100,
+    0x0008004040040200, 0x4002000200100804, 0x0410224400813008, 0x1009000100008042,
+    0x09E0004000808000, 0x8090002000404000, 0x0010002000801080, 0xE280800800801000,
+    0x0008008008800400, 0x0313808400800200, 0x021A011004004802, 0x0400010082000054,
+    0x6041862040048000, 0x8430002000404010, 0x0810220080120040, 0x0020420010220008,
+    0x092A040008008080, 0x0002000804020010, 0x1048100108040002, 0x1280006089020014,
+    0x4080211042048200, 0x1090200040008880, 0xB001001420004100, 0x0000800800100080,
+    0x0008008208040080, 0x022C000200800480, 0x0100E82110121400, 0x0080010864840200,
+    0x0400821020460102, 0x1040204000148103, 0x0000082000401101, 0x400420D830010005,
+    0x0093001002080005, 0x000100140098060F, 0x036C010200900804, 0x0140604084010022,
+};
+}
+
+constexpr Tables::Data Tables::DATA{
+    .white_pawn_attack_table =
+        non_sliding_attack_table(adjacent_attack_set<board::Direction::NORTH_EAST, board::Direction::NORTH_WEST>),
+    .black_pawn_attack_table =
+        non_sliding_attack_table(adjacent_attack_set<board::Direction::SOUTH_EAST, board::Direction::SOUTH_WEST>),
+    .knight_attack_table = non_sliding_attack_table(knight_attack_set),
+    .king_attack_table = non_sliding_attack_table(
+        adjacent_attack_set<board::Direction::NORTH, board::Direction::NORTH_EAST, board::Direction::EAST,
+                            board::Direction::SOUTH_EAST, board::Direction::SOUTH, board::Direction::SOUTH_WEST,
+                            board::Direction::WEST, board::Direction::NORTH_WEST>),
+    .bishop_magic_bitboards = {BISHOP_MAGICS, bishop_mask_contains, bishop_attack_set},
+    .rook_magic_bitboards = {ROOK_MAGICS, rook_mask_contains, rook_attack_set},
+#ifdef PRODIGY_PEXT
+    .bishop_pext_bitboards = {bishop_mask_contains, bishop_attack_set},
+    .rook_pext_bitboards = {rook_mask_contains, rook_attack_set},
+#endif
+    .hyperbola_quintessence = {},
+    .ray_table =
+        [] {
+          board::CoordinateMap<board::CoordinateMap<board::Bitboard>> ray_table;
+          board::for_each_coordinate([&](const auto origin) {
+            board::for_each_coordinate([&](const auto target) {
+              if (file_of(origin) == file_of(target) || rank_of(origin) == rank_of(target)) {
+                ray_table[origin][target] = (rook_attack_set(origin, board::Bitboard(target)) &
+                                             rook_attack_set(target, board::Bitboard(origin))) |
+                                            board::Bitboard(target);
+              } else if (same_diagonal_or_antidiagonal(origin, target)) {
+                ray_table[origin][target] = (bishop_attack_set(origin, board::Bitboard(target)) &
+                                             bishop_attack_set(target, board::Bitboard(origin))) |
+                                            board::Bitboard(target);
+              }
+            });
+          });
+          return ray_table;
+        }(),
+    .line_table =
+        [] {
+          board::CoordinateMap<board::CoordinateMap<board::Bitboard>> line_table;
+          board::for_each_coordinate([&](const auto origin) {
+            board::for_each_coordinate([&](const auto target) {
+              const auto ends = board::Bitboard(origin) | board::Bitboard(target);
+              if (origin == target) {
+                return;
+              }
+              if (file_of(origin) == file_of(target) || rank_of(origin) == rank_of(target)) {
+                line_table[origin][target] =
+                    (rook_attack_set(origin, board::Bitboard()) & rook_attack_set(target, board::Bitboard())) | ends;
+              } else if (same_diagonal_or_antidiagonal(origin, target)) {
+                line_table[origin][target] =
+                    (bishop_attack_set(origin, board::Bitboard()) & bishop_attack_set(target, board::Bitboard())) |
+                    ends;
+              }
+            });
           });
-        });
-        return ray_table;
-      }()) {}
+          return line_table;
+        }(),
+};
+
+const Tables& Tables::instance() {
+  static const Tables TABLES;
+  return TABLES;
+}
 
 board::Bitboard Tables::ray(const board::Coordinate origin, const board::Coordinate target) const {
-  return ray_table_[origin][target];
+  return DATA.ray_table[origin][target];
+}
+
+board::Bitboard Tables::line(const board::Coordinate first, const board::Coordinate second) const {
+  return DATA.line_table[first][second];
 }
 }
@@ -1,54 +1,131 @@
 #pragma once
 
+#include <cstddef>
+
 #include "board/bitboard.h"
 #include "board/color.h"
 #include "board/coordinate.h"
 #include "board/coordinate_map.h"
 #include "board/piece_type.h"
+#include "movegen/hyperbola_quintessence.h"
 #include "movegen/magic_bitboards.h"
+#include "movegen/pext_bitboards.h"
+#include "movegen/slider_backend.h"
 
 namespace prodigy::movegen {
 class Tables final {
  public:
-  Tables();
+  static const Tables& instance();
 
   Tables(const Tables&) = delete;
   Tables& operator=(const Tables&) = delete;
 
-  template <board::Color, board::PieceType>
+  // Any other slider backend than the one fixed at build time is only for comparing backends.
+  template <board::Color, board::PieceType, SliderBackend = SLIDER_BACKEND>
   board::Bitboard attack_set(board::Coordinate origin, board::Bitboard occupancy) const;
+  // For piece types only known at runtime, such as the piece type of a move.
+  template <board::Color>
+  board::Bitboard attack_set(board::PieceType, board::Coordinate origin, board::Bitboard occupancy) const;
   board::Bitboard ray(board::Coordinate origin, board::Coordinate target) const;
+  // The whole rank, file or diagonal through both coordinates, or nothing if they do not share one.
+  board::Bitboard line(board::Coordinate, board::Coordinate) const;
 
  private:
-  const board::CoordinateMap<board::Bitboard> white_pawn_attack_table_;
-  const board::CoordinateMap<board::Bitboard> black_pawn_attack_table_;
-  const board::CoordinateMap<board::Bitboard> knight_attack_table_;
-  const board::CoordinateMap<board::Bitboard> king_attack_table_;
-  const MagicBitboards bishop_magic_bitboards_;
-  const MagicBitboards rook_magic_bitboards_;
-  const board::CoordinateMap<board::CoordinateMap<board::Bitboard>> ray_table_;
+  static constexpr auto BISHOP_ATTACK_TABLE_SIZE = 5'248UZ;
+  static constexpr auto ROOK_ATTACK_TABLE_SIZE = 102'400UZ;
+
+  // Computed entirely at compile time.
+  struct Data final {
+    board::CoordinateMap<board::Bitboard> white_pawn_attack_table;
+    board::CoordinateMap<board::Bitboard> black_pawn_attack_table;
+    board::CoordinateMap<board::Bitboard> knight_attack_table;
+    board::CoordinateMap<board::Bitboard> king_attack_table;
+    MagicBitboards<BISHOP_ATTACK_TABLE_SIZE> bishop_magic_bitboards;
+    MagicBitboards<ROOK_ATTACK_TABLE_SIZE> rook_magic_bitboards;
+#ifdef PRODIGY_PEXT
+    PextBitboards<BISHOP_ATTACK_TABLE_SIZE> bishop_pext_bitboards;
+    PextBitboards<ROOK_ATTACK_TABLE_SIZE> rook_pext_bitboards;
+#endif
+    HyperbolaQuintessence hyperbola_quintessence;
+    board::CoordinateMap<board::CoordinateMap<board::Bitboard>> ray_table;
+    board::CoordinateMap<board::CoordinateMap<board::Bitboard>> line_table;
+  };
+
+  Tables() = default;
+
+  template <board::PieceType, SliderBackend>
+  board::Bitboard sliding_attack_set(board::Coordinate origin, board::Bitboard occupancy) const;
+
+  static const Data DATA;
 };
 
-template <board::Color COLOR, board::PieceType PIECE_TYPE>
+template <board::Color COLOR, board::PieceType PIECE_TYPE, SliderBackend SLIDER_BACKEND_>
 board::Bitboard Tables::attack_set(const board::Coordinate origin, const board::Bitboard occupancy) const {
   if constexpr (PIECE_TYPE == board::PieceType::PAWN) {
     if constexpr (COLOR == board::Color::WHITE) {
-      return white_pawn_attack_table_[origin];
+      return DATA.white_pawn_attack_table[origin];
     } else {
       static_assert(COLOR == board::Color::BLACK);
-      return black_pawn_attack_table_[origin];
+      return DATA.black_pawn_attack_table[origin];
     }
   } else if constexpr (PIECE_TYPE == board::PieceType::KNIGHT) {
-    return knight_attack_table_[origin];
+    return DATA.knight_attack_table[origin];
   } else if constexpr (PIECE_TYPE == board::PieceType::KING) {
-    return king_attack_table_[origin];
-  } else if constexpr (PIECE_TYPE == board::PieceType::BISHOP) {
-    return bishop_magic_bitboards_.attack_set(origin, occupancy);
-  } else if constexpr (PIECE_TYPE == board::PieceType::ROOK) {
-    return rook_magic_bitboards_.attack_set(origin, occupancy);
+    return DATA.king_attack_table[origin];
+  } else if constexpr (PIECE_TYPE == board::PieceType::QUEEN) {
+    return sliding_attack_set<board::PieceType::BISHOP, SLIDER_BACKEND_>(origin, occupancy) |
+           sliding_attack_set<board::PieceType::ROOK, SLIDER_BACKEND_>(origin, occupancy);
+  } else {
+    return sliding_attack_set<PIECE_TYPE, SLIDER_BACKEND_>(origin, occupancy);
+  }
+}
+
+template <board::Color COLOR>
+board::Bitboard Tables::attack_set(const board::PieceType piece_type, const board::Coordinate origin,
+                                   const board::Bitboard occupancy) const {
+  switch (piece_type) {
+    case board::PieceType::PAWN:
+      return attack_set<COLOR, board::PieceType::PAWN>(origin, occupancy);
+    case board::PieceType::KNIGHT:
+      return attack_set<COLOR, board::PieceType::KNIGHT>(origin, occupancy);
+    case board::PieceType::BISHOP:
+      return attack_set<COLOR, board::PieceType::BISHOP>(origin, occupancy);
+    case board::PieceType::ROOK:
+      return attack_set<COLOR, board::PieceType::ROOK>(origin, occupancy);
+    case board::PieceType::QUEEN:
+      return attack_set<COLOR, board::PieceType::QUEEN>(origin, occupancy);
+    case board::PieceType::KING:
+      return attack_set<COLOR, board::PieceType::KING>(origin, occupancy);
+  }
+  __builtin_unreachable();
+}
+
+template <board::PieceType PIECE_TYPE, SliderBackend SLIDER_BACKEND_>
+board::Bitboard Tables::sliding_attack_set(const board::Coordinate origin, const board::Bitboard occupancy) const {
+  static_assert(PIECE_TYPE == board::PieceType::BISHOP || PIECE_TYPE == board::PieceType::ROOK);
+  if constexpr (SLIDER_BACKEND_ == SliderBackend::PEXT) {
+#ifdef PRODIGY_PEXT
+    if constexpr (PIECE_TYPE == board::PieceType::BISHOP) {
+      return DATA.bishop_pext_bitboards.attack_set(origin, occupancy);
+    } else {
+      return DATA.rook_pext_bitboards.attack_set(origin, occupancy);
+    }
+#else
+    static_assert(SLIDER_BACKEND_ != SliderBackend::PEXT, "The PEXT slider backend requires PRODIGY_PEXT.");
+#endif
+  } else if constexpr (SLIDER_BACKEND_ == SliderBackend::HYPERBOLA_QUINTESSENCE) {
+    if constexpr (PIECE_TYPE == board::PieceType::BISHOP) {
+      return DATA.hyperbola_quintessence.bishop_attack_set(origin, occupancy);
+    } else {
+      return DATA.hyperbola_quintessence.rook_attack_set(origin, occupancy);
+    }
   } else {
-    static_assert(PIECE_TYPE == board::PieceType::QUEEN);
-    return bishop_magic_bitboards_.attack_set(origin, occupancy) | rook_magic_bitboards_.attack_set(origin, occupancy);
+    static_assert(SLIDER_BACKEND_ == SliderBackend::MAGIC);
+    if constexpr (PIECE_TYPE == board::PieceType::BISHOP) {
+      return DATA.bishop_magic_bitboards.attack_set(origin, occupancy);
+    } else {
+      return DATA.rook_magic_bitboards.attack_set(origin, occupancy);
+    }
   }
 }
 }
@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE AttackMap
+
+#include "movegen/attack_map.h"
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/position.h"
+#include "movegen/move_generator.h"
+#include "movegen/tables.h"
+#include "movegen/tests/perft_positions.h"
+
+namespace prodigy::movegen {
+namespace {
+// Checks the attack map against the one computed from scratch and against the attackers of every square.
+void expect_attack_map_matches(const MoveGenerator& move_generator, const board::Position& position,
+                               const AttackMap& attack_map) {
+  const auto& tables = Tables::instance();
+  BOOST_TEST_REQUIRE((attack_map == AttackMap(tables, position)));
+  const auto occupancy = position.occupancy();
+  board::Bitboard white_attack_set;
+  board::Bitboard black_attack_set;
+  board::for_each_coordinate([&](const auto coordinate) {
+    const auto attackers = move_generator.attackers_to(position, coordinate, occupancy);
+    const auto white_attacker_count = (attackers & position.all_pieces<board::Color::WHITE>()).popcount();
+    const auto black_attacker_count = (attackers & position.all_pieces<board::Color::BLACK>()).popcount();
+    BOOST_TEST_REQUIRE(attack_map.attacker_count<board::Color::WHITE>(coordinate) == white_attacker_count);
+    BOOST_TEST_REQUIRE(attack_map.attacker_count<board::Color::BLACK>(coordinate) == black_attacker_count);
+    if (white_attacker_count) {
+      white_attack_set |= board::Bitboard(coordinate);
+    }
+    if (black_attacker_count) {
+      black_attack_set |= board::Bitboard(coordinate);
+    }
+  });
+  BOOST_TEST_REQUIRE((attack_map.attack_set<board::Color::WHITE>() == white_attack_set));
+  BOOST_TEST_REQUIRE((attack_map.attack_set<board::Color::BLACK>() == black_attack_set));
+}
+
+struct Node final {
+  board::Position position;
+  AttackMap attack_map;
+};
+
+BOOST_AUTO_TEST_CASE(updates_match_from_scratch) {
+  const auto& tables = Tables::instance();
+  for (const auto fen : PERFT_FENS) {
+    // The positions from the root to the one being visited, each with the attack map updated down to it.
+    std::vector<Node> path;
+    for_each_reachable_position(
+        fen, 3, [&]<board::Color>(const MoveGenerator& move_generator, const board::Position& position, const Ply ply) {
+          path.erase(path.begin() + ply, path.end());
+          if (path.empty()) {
+            path.push_back({.position = position, .attack_map = AttackMap(tables, position)});
+          } else {
+            const auto& parent = path.back();
+            auto attack_map = parent.attack_map;
+            attack_map.update(tables, parent.position, position);
+            auto reverted_attack_map = attack_map;
+            reverted_attack_map.update(tables, position, parent.position);
+            BOOST_TEST_REQUIRE((reverted_attack_map == parent.attack_map));
+            path.push_back({.position = position, .attack_map = attack_map});
+          }
+          expect_attack_map_matches(move_generator, position, path.back().attack_map);
+        });
+  }
+}
+}
+}
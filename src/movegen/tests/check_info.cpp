@@ -0,0 +1,120 @@
+#define BOOST_TEST_MODULE CheckInfo
+
+#include "movegen/check_info.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "base/ply.h"
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/piece_type.h"
+#include "board/position.h"
+#include "movegen/move_generator.h"
+#include "movegen/tables.h"
+#include "movegen/tests/perft_positions.h"
+
+namespace prodigy::movegen {
+namespace {
+// Checks the check info of the position against a brute force computation from the pieces it names.
+template <board::Color ACTIVE_COLOR>
+void expect_check_info_matches(const MoveGenerator& move_generator, const board::Position& position) {
+  const auto& tables = Tables::instance();
+  const auto check_info = move_generator.check_info<ACTIVE_COLOR>(position);
+  const auto occupancy = position.occupancy();
+  const auto king = position.pieces<ACTIVE_COLOR, board::PieceType::KING>();
+  const auto slider_attacker_set = [&](const auto occupancy_without_blocker) {
+    return (tables.attack_set<ACTIVE_COLOR, board::PieceType::BISHOP>(unsafe_to_coordinate(king),
+                                                                      occupancy_without_blocker) &
+            position.pieces<~ACTIVE_COLOR, board::PieceType::BISHOP, board::PieceType::QUEEN>()) |
+           (tables.attack_set<ACTIVE_COLOR, board::PieceType::ROOK>(unsafe_to_coordinate(king),
+                                                                    occupancy_without_blocker) &
+            position.pieces<~ACTIVE_COLOR, board::PieceType::ROOK, board::PieceType::QUEEN>());
+  };
+
+  board::Bitboard checkers;
+  board::Bitboard pinned;
+  board::Bitboard pinners;
+  board::for_each_coordinate([&](const auto coordinate) {
+    const auto piece = position.piece_at(coordinate);
+    if (!piece || piece.piece_type() == board::PieceType::KING) {
+      return;
+    }
+    if (piece.color() == ~ACTIVE_COLOR) {
+      // Looks from the attacker instead of from the king.
+      const auto attacks_king = [&]<board::PieceType PIECE_TYPE> {
+        return static_cast<bool>(tables.attack_set<~ACTIVE_COLOR, PIECE_TYPE>(coordinate, occupancy) & king);
+      };
+      const auto gives_check = [&] {
+        switch (piece.piece_type()) {
+          case board::PieceType::PAWN:
+            return attacks_king.template operator()<board::PieceType::PAWN>();
+          case board::PieceType::KNIGHT:
+            return attacks_king.template operator()<board::PieceType::KNIGHT>();
+          case board::PieceType::BISHOP:
+            return attacks_king.template operator()<board::PieceType::BISHOP>();
+          case board::PieceType::ROOK:
+            return attacks_king.template operator()<board::PieceType::ROOK>();
+          default:
+            return attacks_king.template operator()<board::PieceType::QUEEN>();
+        }
+      }();
+      if (gives_check) {
+        checkers |= board::Bitboard(coordinate);
+      }
+      return;
+    }
+    // Removing a pinned piece exposes the king to its pinner.
+    if (const auto exposed_by = slider_attacker_set(occupancy ^ board::Bitboard(coordinate)) &
+                                ~slider_attacker_set(occupancy)) {
+      pinned |= board::Bitboard(coordinate);
+      pinners |= exposed_by;
+    }
+  });
+  BOOST_TEST_REQUIRE((check_info.checkers == checkers));
+  BOOST_TEST_REQUIRE((check_info.pinned == pinned));
+  BOOST_TEST_REQUIRE((check_info.pinners == pinners));
+  BOOST_TEST_REQUIRE(!check_info.check_squares[board::PieceType::KING]);
+
+  const auto enemy_king = position.pieces<~ACTIVE_COLOR, board::PieceType::KING>();
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+    // A promotion can open a line to the enemy king through its origin behind its target. Any other move cannot,
+    // since the enemy king would have been in check already.
+    const auto piece_type = move.piece_type();
+    if (piece_type == board::PieceType::KING || move.promotion().has_value()) {
+      continue;
+    }
+    const auto child = position.apply<ACTIVE_COLOR>(move);
+    const auto attack_set = [&]<board::PieceType PIECE_TYPE> {
+      return tables.attack_set<ACTIVE_COLOR, PIECE_TYPE>(move.target(), child.occupancy());
+    };
+    const auto attacks_enemy_king = [&] {
+      switch (piece_type) {
+        case board::PieceType::PAWN:
+          return attack_set.template operator()<board::PieceType::PAWN>() & enemy_king;
+        case board::PieceType::KNIGHT:
+          return attack_set.template operator()<board::PieceType::KNIGHT>() & enemy_king;
+        case board::PieceType::BISHOP:
+          return attack_set.template operator()<board::PieceType::BISHOP>() & enemy_king;
+        case board::PieceType::ROOK:
+          return attack_set.template operator()<board::PieceType::ROOK>() & enemy_king;
+        default:
+          return attack_set.template operator()<board::PieceType::QUEEN>() & enemy_king;
+      }
+    }();
+    BOOST_TEST_REQUIRE(static_cast<bool>(check_info.check_squares[piece_type] & board::Bitboard(move.target())) ==
+                       static_cast<bool>(attacks_enemy_king));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(matches_brute_force) {
+  for (const auto fen : PERFT_FENS) {
+    for_each_reachable_position(fen, 2,
+                                []<board::Color ACTIVE_COLOR>(const MoveGenerator& move_generator,
+                                                              const board::Position& position, Ply) {
+                                  expect_check_info_matches<ACTIVE_COLOR>(move_generator, position);
+                                });
+  }
+}
+}
+}
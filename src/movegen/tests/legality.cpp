@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE Legality
+
+#include <algorithm>
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/move.h"
+#include "board/piece_type.h"
+#include "board/position.h"
+#include "movegen/check_info.h"
+#include "movegen/move_generator.h"
+#include "movegen/tests/perft_positions.h"
+
+namespace prodigy::movegen {
+namespace {
+constexpr auto RANDOM_MOVES_PER_NODE = 64;
+constexpr Ply MAX_PLY_CHECKED = 2;
+
+// Fuzzes single move validation against generate, with the moves of the parent position standing in for killer moves
+// and random compact moves standing in for corrupt transposition table moves. At the root, every combination of origin,
+// target and promotion is tried too. Returns the moves of the position.
+template <board::Color ACTIVE_COLOR>
+std::vector<board::Move> expect_validation_matches(const MoveGenerator& move_generator,
+                                                   const board::Position& position,
+                                                   const std::vector<board::Move>& parent_moves, const Ply ply,
+                                                   std::mt19937_64& engine) {
+  const auto check_info = move_generator.check_info<ACTIVE_COLOR>(position);
+  const auto move_list = move_generator.generate<ACTIVE_COLOR>(position);
+  std::vector<board::Move> moves(move_list.begin(), move_list.end());
+  std::vector<std::uint16_t> compact_moves;
+  for (const auto move : moves) {
+    compact_moves.push_back(move.compact());
+  }
+  std::ranges::sort(compact_moves);
+  const auto expect_matches = [&](const board::Move move) {
+    const auto is_legal = move_generator.is_pseudo_legal<ACTIVE_COLOR>(position, check_info, move) &&
+                          move_generator.is_legal<ACTIVE_COLOR>(position, check_info, move);
+    BOOST_TEST_REQUIRE(is_legal == std::ranges::binary_search(compact_moves, move.compact()),
+                       position.fen() << ' ' << move);
+  };
+
+  for (const auto move : moves) {
+    expect_matches(board::Move::from_compact(move.compact()));
+    const auto child = position.apply<ACTIVE_COLOR>(move);
+    BOOST_TEST_REQUIRE(move_generator.gives_check<ACTIVE_COLOR>(position, check_info, move) ==
+                           static_cast<bool>(move_generator.check_info<~ACTIVE_COLOR>(child).checkers),
+                       position.fen() << ' ' << move);
+  }
+  for (const auto move : parent_moves) {
+    expect_matches(board::Move::from_compact(move.compact()));
+  }
+  // The top bit of a compact move is always clear.
+  std::uniform_int_distribution<std::uint16_t> compact_move(0, 0x7FFF);
+  for (auto i = 0; i < RANDOM_MOVES_PER_NODE; ++i) {
+    expect_matches(board::Move::from_compact(compact_move(engine)));
+  }
+  if (ply == 0) {
+    for (std::uint16_t compact_move = 0; compact_move < 0x8000; ++compact_move) {
+      expect_matches(board::Move::from_compact(compact_move));
+    }
+  }
+  return moves;
+}
+
+void expect_matches(const std::string_view fen) {
+  // The moves of the last position visited at each ply, one slot down, so that each position finds its parent's moves
+  // in its own slot and the root finds none.
+  std::array<std::vector<board::Move>, MAX_PLY_CHECKED + 2> ply_to_parent_moves;
+  // Seeded so that a failure reproduces.
+  std::mt19937_64 engine(0);
+  for_each_reachable_position(
+      fen, MAX_PLY_CHECKED,
+      [&]<board::Color ACTIVE_COLOR>(const MoveGenerator& move_generator, const board::Position& position,
+                                     const Ply ply) {
+        ply_to_parent_moves[ply + 1] =
+            expect_validation_matches<ACTIVE_COLOR>(move_generator, position, ply_to_parent_moves[ply], ply, engine);
+      });
+}
+
+BOOST_AUTO_TEST_CASE(matches_generate) {
+  for (const auto fen : PERFT_FENS) {
+    expect_matches(fen);
+  }
+  // En passant out of a check given by the pawn that double pushed, and en passant that would discover a check.
+  expect_matches("8/8/8/2k5/3Pp3/8/8/4K3 b - d3 0 1");
+  expect_matches("8/8/8/KPp4r/8/8/8/7k w - c6 0 1");
+}
+}
+}
@@ -0,0 +1,125 @@
+#define BOOST_TEST_MODULE MoveGenerator
+
+#include "movegen/move_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/move.h"
+#include "board/piece_type.h"
+#include "board/position.h"
+#include "movegen/generation_type.h"
+#include "movegen/king_danger.h"
+#include "movegen/move_list.h"
+#include "movegen/scored_move.h"
+#include "movegen/tables.h"
+#include "movegen/tests/perft_positions.h"
+
+namespace prodigy::movegen {
+namespace {
+template <board::Color ACTIVE_COLOR>
+bool in_check(const board::Position& position) {
+  const auto& tables = Tables::instance();
+  const auto king_coordinate = unsafe_to_coordinate(position.pieces<ACTIVE_COLOR, board::PieceType::KING>());
+  const auto occupancy = position.all_pieces<ACTIVE_COLOR>() | position.all_pieces<~ACTIVE_COLOR>();
+  const auto attacked_by = [&]<board::PieceType PIECE_TYPE> {
+    return static_cast<bool>(tables.attack_set<ACTIVE_COLOR, PIECE_TYPE>(king_coordinate, occupancy) &
+                             position.pieces<~ACTIVE_COLOR, PIECE_TYPE>());
+  };
+  return attacked_by.template operator()<board::PieceType::PAWN>() ||
+         attacked_by.template operator()<board::PieceType::KNIGHT>() ||
+         attacked_by.template operator()<board::PieceType::BISHOP>() ||
+         attacked_by.template operator()<board::PieceType::ROOK>() ||
+         attacked_by.template operator()<board::PieceType::QUEEN>();
+}
+
+std::vector<board::Move> sorted(const MoveList& move_list) {
+  std::vector<board::Move> moves(move_list.begin(), move_list.end());
+  std::ranges::sort(moves);
+  return moves;
+}
+
+// Checks the staged generation of a position against generating every move at once, and returns how many moves the
+// stages generate together.
+template <board::Color ACTIVE_COLOR>
+std::size_t expect_staged_generation_matches(const MoveGenerator& move_generator, const board::Position& position) {
+  const auto all = move_generator.generate<ACTIVE_COLOR>(position);
+  const auto captures = move_generator.generate<ACTIVE_COLOR, GenerationType::CAPTURES>(position);
+  const auto quiets = move_generator.generate<ACTIVE_COLOR, GenerationType::QUIETS>(position);
+  BOOST_TEST_REQUIRE((move_generator.count<ACTIVE_COLOR>(position) == all.size()));
+  static const MoveGenerator EAGER_MOVE_GENERATOR(KingDanger::EAGER);
+  static const MoveGenerator LAZY_MOVE_GENERATOR(KingDanger::LAZY);
+  for (const auto* const king_danger_move_generator : {&EAGER_MOVE_GENERATOR, &LAZY_MOVE_GENERATOR}) {
+    BOOST_TEST_REQUIRE(std::ranges::equal(king_danger_move_generator->template generate<ACTIVE_COLOR>(position), all));
+    BOOST_TEST_REQUIRE((king_danger_move_generator->template count<ACTIVE_COLOR>(position) == all.size()));
+  }
+  std::array<ScoredMove, MAX_MOVES> scored_moves;
+  const auto scored_moves_end = move_generator.generate<ACTIVE_COLOR>(
+      position, move_generator.check_info<ACTIVE_COLOR>(position), scored_moves.data());
+  BOOST_TEST_REQUIRE(
+      std::ranges::equal(std::ranges::subrange(scored_moves.data(), scored_moves_end), all, {}, &ScoredMove::move));
+  for (const auto move : all) {
+    BOOST_TEST_REQUIRE(
+        (position.annotate<ACTIVE_COLOR>(board::Move(move.origin(), move.target(), move.promotion())) == move));
+    BOOST_TEST_REQUIRE(position.hash_after<ACTIVE_COLOR>(move) == position.apply<ACTIVE_COLOR>(move).hash());
+  }
+  BOOST_TEST_REQUIRE((move_generator.count<ACTIVE_COLOR, GenerationType::CAPTURES>(position) == captures.size()));
+  BOOST_TEST_REQUIRE((move_generator.count<ACTIVE_COLOR, GenerationType::QUIETS>(position) == quiets.size()));
+
+  const auto is_capture = [&](const auto move) {
+    return static_cast<bool>(position.all_pieces<~ACTIVE_COLOR>() & board::Bitboard(move.target())) ||
+           (move.target() == position.en_passant_target() &&
+            position.piece_type_at<ACTIVE_COLOR>(move.origin()) == board::PieceType::PAWN);
+  };
+  for (const auto move : all) {
+    BOOST_TEST_REQUIRE(move.is_capture() == is_capture(move));
+  }
+  for (const auto move : captures) {
+    BOOST_TEST_REQUIRE(
+        (move.promotion().has_value() ? *move.promotion() == board::PieceType::QUEEN : is_capture(move)));
+  }
+  for (const auto move : quiets) {
+    BOOST_TEST_REQUIRE(
+        (move.promotion().has_value() ? *move.promotion() != board::PieceType::QUEEN : !is_capture(move)));
+  }
+  std::vector<board::Move> staged;
+  std::ranges::merge(sorted(captures), sorted(quiets), std::back_inserter(staged));
+  BOOST_TEST_REQUIRE(std::ranges::equal(staged, sorted(all)));
+  if (in_check<ACTIVE_COLOR>(position)) {
+    const auto evasions = move_generator.generate<ACTIVE_COLOR, GenerationType::EVASIONS>(position);
+    BOOST_TEST_REQUIRE(std::ranges::equal(sorted(evasions), sorted(all)));
+    BOOST_TEST_REQUIRE((move_generator.count<ACTIVE_COLOR, GenerationType::EVASIONS>(position) == evasions.size()));
+  }
+
+  return staged.size();
+}
+
+BOOST_AUTO_TEST_CASE(staged_generation) {
+  // The leaves three plies below each position, counted from the staged moves alone.
+  constexpr std::uint64_t LEAF_COUNTS[] = {8'902, 97'862, 2'812, 9'467, 62'379, 9'483};
+  static_assert(std::size(LEAF_COUNTS) == std::size(PERFT_FENS));
+  for (auto i = 0UZ; i < std::size(PERFT_FENS); ++i) {
+    std::uint64_t leaf_count = 0;
+    for_each_reachable_position(
+        PERFT_FENS[i], 2,
+        [&]<board::Color ACTIVE_COLOR>(const MoveGenerator& move_generator, const board::Position& position,
+                                       const Ply ply) {
+          const auto staged_count = expect_staged_generation_matches<ACTIVE_COLOR>(move_generator, position);
+          if (ply == 2) {
+            leaf_count += staged_count;
+          }
+        });
+    BOOST_TEST(leaf_count == LEAF_COUNTS[i], PERFT_FENS[i]);
+  }
+}
+}
+}
@@ -5,6 +5,9 @@
 #include <algorithm>
 #include <boost/test/unit_test.hpp>
 #include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -13,6 +16,7 @@
 #include "board/position.h"
 #include "board/starting_position_fen.h"
 #include "movegen/move_generator.h"
+#include "movegen/perft_cache.h"
 
 namespace prodigy::movegen {
 namespace {
@@ -27,14 +31,65 @@ void expect(const std::string_view fen, const std::vector<std::uint64_t>& expect
   BOOST_TEST_REQUIRE(std::in_range<Ply>(depth));
   BOOST_TEST_REQUIRE(depth < expected_depth_to_node_count.size());
 
-  const auto result = perft(MOVE_GENERATOR, board::Position::from_fen(fen), depth);
-  BOOST_TEST_REQUIRE(result.depth_to_node_count.size() - 1 == depth);
+  for (const auto perft_strategy : {PerftStrategy::COPY_MAKE, PerftStrategy::MAKE_UNMAKE}) {
+    const auto result = perft(MOVE_GENERATOR, board::Position::from_fen(fen), depth, perft_strategy);
+    BOOST_TEST_REQUIRE(result.depth_to_node_count.size() - 1 == depth);
 
+    for (auto i = 0UZ; i < result.depth_to_node_count.size(); ++i) {
+      BOOST_TEST_REQUIRE(result.depth_to_node_count[i] == expected_depth_to_node_count[i]);
+    }
+  }
+
+  PerftCache cache(64);
+  const auto result =
+      perft(MOVE_GENERATOR, board::Position::from_fen(fen), depth, PerftStrategy::COPY_MAKE, {}, &cache);
   for (auto i = 0UZ; i < result.depth_to_node_count.size(); ++i) {
     BOOST_TEST_REQUIRE(result.depth_to_node_count[i] == expected_depth_to_node_count[i]);
   }
 }
 
+// Splits at every ply, including those past the last one, which are clamped.
+void expect_parallel(const std::string_view fen, const std::vector<std::uint64_t>& expected_depth_to_node_count) {
+  static const MoveGenerator MOVE_GENERATOR;
+  const auto depth = static_cast<Ply>(expected_depth_to_node_count.size() - 1);
+  for (auto split_ply = 0; split_ply <= depth + 1; ++split_ply) {
+    for (const auto thread_count : {2U, 3U}) {
+      const PerftParallelism parallelism{.thread_count = thread_count, .split_ply = static_cast<Ply>(split_ply)};
+      for (const auto perft_strategy : {PerftStrategy::COPY_MAKE, PerftStrategy::MAKE_UNMAKE}) {
+        const auto result = perft(MOVE_GENERATOR, board::Position::from_fen(fen), depth, perft_strategy, parallelism);
+        BOOST_TEST_REQUIRE(result.depth_to_node_count == expected_depth_to_node_count);
+
+        PerftCache cache(1);
+        const auto hashed_result =
+            perft(MOVE_GENERATOR, board::Position::from_fen(fen), depth, perft_strategy, parallelism, &cache);
+        BOOST_TEST_REQUIRE(hashed_result.depth_to_node_count == expected_depth_to_node_count);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(divide) {
+  static const MoveGenerator MOVE_GENERATOR;
+  std::map<std::string, std::uint64_t> move_to_leaf_count;
+  for (const auto& [move, leaf_count] : movegen::divide(MOVE_GENERATOR, board::Position::starting_position(), 3)) {
+    std::ostringstream os;
+    os << move;
+    move_to_leaf_count.emplace(os.str(), leaf_count);
+  }
+  BOOST_TEST((move_to_leaf_count == std::map<std::string, std::uint64_t>{
+                                        {"a2a3", 380}, {"b2b3", 420}, {"c2c3", 420}, {"d2d3", 539}, {"e2e3", 599},
+                                        {"f2f3", 380}, {"g2g3", 420}, {"h2h3", 380}, {"a2a4", 420}, {"b2b4", 421},
+                                        {"c2c4", 441}, {"d2d4", 560}, {"e2e4", 600}, {"f2f4", 401}, {"g2g4", 421},
+                                        {"h2h4", 420}, {"b1a3", 400}, {"b1c3", 440}, {"g1f3", 440}, {"g1h3", 400},
+                                    }));
+}
+
+BOOST_AUTO_TEST_CASE(parallel) {
+  expect_parallel(board::STARTING_POSITION_FEN, {1, 20, 400, 8'902, 197'281});
+  expect_parallel("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", {1, 48, 2'039, 97'862});
+  expect_parallel("rnbQkbnr/3ppppp/p1p5/8/8/2P5/PP1PPPPP/RNB1KBNR b KQkq - 0 4", {1, 1, 19, 342, 7'095});
+}
+
 BOOST_AUTO_TEST_CASE(one) {
   expect(board::STARTING_POSITION_FEN, {
                                            1,
@@ -0,0 +1,28 @@
+#define BOOST_TEST_MODULE PerftCache
+
+#include "movegen/perft_cache.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+
+#include "base/uniform_distribution.h"
+#include "zobrist/hash.h"
+
+namespace prodigy::movegen {
+namespace {
+BOOST_AUTO_TEST_CASE(find_and_store) {
+  PerftCache cache(1);
+  const auto hash = uniform_distribution<zobrist::Hash>();
+  BOOST_TEST(!cache.find(hash, 3).has_value());
+  cache.store(hash, 3, 8'902);
+  BOOST_TEST((cache.find(hash, 3) == 8'902U));
+  BOOST_TEST(!cache.find(hash, 4).has_value());
+  BOOST_TEST(!cache.find(hash ^ 1, 3).has_value());
+
+  static constexpr std::uint64_t MAX_LEAF_COUNT = (std::uint64_t{1} << 56) - 1;
+  cache.store(hash, 4, MAX_LEAF_COUNT);
+  BOOST_TEST((cache.find(hash, 4) == MAX_LEAF_COUNT));
+  BOOST_TEST(!cache.find(hash, 3).has_value());
+}
+}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string_view>
+
+#include "base/ply.h"
+#include "board/color.h"
+#include "board/position.h"
+#include "board/starting_position_fen.h"
+#include "movegen/move_generator.h"
+
+namespace prodigy::movegen {
+// The positions of the usual perft suite, which between them cover castling, en passant, promotions, checks and pins.
+inline constexpr std::string_view PERFT_FENS[] = {
+    board::STARTING_POSITION_FEN,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+};
+
+template <board::Color ACTIVE_COLOR, typename Visitor>
+void for_each_reachable_position(const MoveGenerator& move_generator, const board::Position& position, const Ply ply,
+                                 const Ply max_ply, Visitor& visitor) {
+  visitor.template operator()<ACTIVE_COLOR>(move_generator, position, ply);
+  if (ply == max_ply) {
+    return;
+  }
+  for (const auto move : move_generator.generate<ACTIVE_COLOR>(position)) {
+    for_each_reachable_position<~ACTIVE_COLOR>(move_generator, position.apply<ACTIVE_COLOR>(move),
+                                               static_cast<Ply>(ply + 1), max_ply, visitor);
+  }
+}
+
+// Calls the visitor with the move generator, every position within max_ply plies of the FEN and its ply, each position
+// before the positions below it. The visitor takes the color to move as a template argument.
+template <typename Visitor>
+void for_each_reachable_position(const std::string_view fen, const Ply max_ply, Visitor&& visitor) {
+  static const MoveGenerator MOVE_GENERATOR;
+  const auto position = board::Position::from_fen(fen);
+  if (position.active_color() == board::Color::WHITE) {
+    for_each_reachable_position<board::Color::WHITE>(MOVE_GENERATOR, position, 0, max_ply, visitor);
+  } else {
+    for_each_reachable_position<board::Color::BLACK>(MOVE_GENERATOR, position, 0, max_ply, visitor);
+  }
+}
+}
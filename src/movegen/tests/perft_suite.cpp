@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE PerftSuite
+
+#include "movegen/perft_suite.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/ply.h"
+#include "board/position.h"
+#include "board/starting_position_fen.h"
+#include "movegen/move_generator.h"
+
+namespace prodigy::movegen {
+namespace {
+BOOST_AUTO_TEST_CASE(parse) {
+  const auto entry = parse_perft_suite_entry("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20 ;D2 400");
+  BOOST_TEST_REQUIRE(entry.has_value());
+  BOOST_TEST(entry->position.fen() == board::Position::starting_position().fen());
+  BOOST_TEST((entry->depth_to_leaf_count == std::vector<std::pair<Ply, std::uint64_t>>{{1, 20}, {2, 400}}));
+
+  BOOST_TEST(parse_perft_suite_entry(std::string(board::STARTING_POSITION_FEN) + " ;D3 8902").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq ;D1 20").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;E1 20").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D0 1").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - ;D1 20").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBN w KQkq - ;D1 20").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20").has_value());
+}
+
+BOOST_AUTO_TEST_CASE(parse_unreachable_position) {
+  BOOST_TEST(parse_perft_suite_entry("4k3/8/8/8/8/P7/PPPPPPP1/4K3 w - - ;D1 13").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/8/8/8/P7/PPPPPPPP/4K3 w - - ;D1 14").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/8/8/8/pppppppp/p7/4K3 b - - ;D1 14").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/8/8/NNNNNNNN/NNNNNNNN/8/4K3 w - - ;D1 1").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/8/8/RRRRRRRR/RRRRRRRP/8/4K3 w - - ;D1 1").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("P3k3/8/8/8/8/8/8/4K3 w - - ;D1 5").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/8/8/8/8/8/p3K3 w - - ;D1 5").has_value());
+}
+
+BOOST_AUTO_TEST_CASE(parse_en_passant_target) {
+  BOOST_TEST(parse_perft_suite_entry("4k3/8/8/3Pp3/8/8/8/4K3 w - e6 ;D1 7").has_value());
+  BOOST_TEST(parse_perft_suite_entry("4k3/8/8/8/3pP3/8/8/4K3 b - e3 ;D1 7").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/8/3P4/8/8/8/4K3 w - e6 ;D1 6").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/8/3PP3/8/8/8/4K3 w - e6 ;D1 6").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/4n3/3Pp3/8/8/8/4K3 w - e6 ;D1 6").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/4n3/8/3Pp3/8/8/8/4K3 w - e6 ;D1 6").has_value());
+  BOOST_TEST(!parse_perft_suite_entry("4k3/8/8/8/3p4/8/8/4K3 b - e3 ;D1 6").has_value());
+}
+
+BOOST_AUTO_TEST_CASE(run) {
+  static const MoveGenerator MOVE_GENERATOR;
+  const auto run = [](const std::string& suite, const Ply max_depth = MAX_PLY) {
+    std::istringstream is(suite);
+    std::ostringstream os;
+    return run_perft_suite(MOVE_GENERATOR, is, os, 2, max_depth);
+  };
+  BOOST_TEST(run("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20 ;D2 400 ;D3 8902\n"
+                 "\n"
+                 "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1 ;D1 14 ;D2 191 ;D3 2812\n"));
+  BOOST_TEST(!run("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20 ;D2 401\n"));
+  BOOST_TEST(!run("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20\nnot a position\n"));
+  BOOST_TEST(!run("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20\n"
+                  "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - ;D1 20\n"));
+  BOOST_TEST(run("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20 ;D2 401\n", 1));
+}
+
+BOOST_AUTO_TEST_CASE(report) {
+  static const MoveGenerator MOVE_GENERATOR;
+  std::istringstream is(
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20\n"
+      "not a position\n"
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D3 8902\n"
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 21\n");
+  std::ostringstream os;
+  BOOST_TEST(!run_perft_suite(MOVE_GENERATOR, is, os, 2, 2));
+  const auto report = os.str();
+  BOOST_TEST(report.starts_with(
+      "  PASS  rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20\n"
+      "  SKIP  not a position: cannot parse\n"
+      "  SKIP  rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D3 8902: no depth <= 2\n"
+      "  FAIL  rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 21: D1 counted 20\n"
+      "\n"
+      "   Passed: 1/4\n"
+      "  Skipped: 2\n"));
+}
+}
+}
@@ -0,0 +1,94 @@
+#define BOOST_TEST_MODULE See
+
+#include <boost/test/unit_test.hpp>
+#include <string_view>
+
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/move.h"
+#include "board/piece_type.h"
+#include "board/position.h"
+#include "eval/score.h"
+#include "movegen/move_generator.h"
+#include "movegen/tables.h"
+
+namespace prodigy::movegen {
+namespace {
+const MoveGenerator& move_generator() {
+  static const MoveGenerator MOVE_GENERATOR;
+  return MOVE_GENERATOR;
+}
+
+// Checks that the exchange scores exactly the expected value by checking thresholds on either side of it.
+void expect_see(const std::string_view fen, const std::string_view move, const eval::Score expected_score) {
+  const auto position = board::Position::from_fen(fen);
+  const auto see_ge = [&]<board::Color ACTIVE_COLOR>(const eval::Score threshold) {
+    return move_generator().see_ge<ACTIVE_COLOR>(position, position.annotate<ACTIVE_COLOR>(board::Move(move)),
+                                                 threshold);
+  };
+  if (position.active_color() == board::Color::WHITE) {
+    BOOST_TEST(see_ge.template operator()<board::Color::WHITE>(expected_score), fen << ' ' << move);
+    BOOST_TEST(!see_ge.template operator()<board::Color::WHITE>(expected_score + 1), fen << ' ' << move);
+  } else {
+    BOOST_TEST(see_ge.template operator()<board::Color::BLACK>(expected_score), fen << ' ' << move);
+    BOOST_TEST(!see_ge.template operator()<board::Color::BLACK>(expected_score + 1), fen << ' ' << move);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(attackers_to) {
+  const auto& tables = Tables::instance();
+  const auto position =
+      board::Position::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  const auto occupancy = position.occupancy();
+  board::for_each_coordinate([&](const auto coordinate) {
+    board::Bitboard attackers;
+    board::for_each_coordinate([&](const auto origin) {
+      const auto piece = position.piece_at(origin);
+      if (!piece) {
+        return;
+      }
+      const auto attack_set = piece.color() == board::Color::WHITE
+                                  ? tables.attack_set<board::Color::WHITE>(piece.piece_type(), origin, occupancy)
+                                  : tables.attack_set<board::Color::BLACK>(piece.piece_type(), origin, occupancy);
+      if (attack_set & board::Bitboard(coordinate)) {
+        attackers |= board::Bitboard(origin);
+      }
+    });
+    BOOST_TEST_REQUIRE((move_generator().attackers_to(position, coordinate, occupancy) == attackers));
+  });
+}
+
+BOOST_AUTO_TEST_CASE(simple_exchanges) {
+  expect_see("4k3/8/8/3p4/4P3/8/8/4K3 w - - 0 1", "e4d5", 100);
+  expect_see("4k3/8/8/3p4/4P3/8/8/4K3 b - - 0 1", "d5e4", 100);
+  expect_see("4k3/8/2p5/3p4/4P3/8/8/4K3 w - - 0 1", "e4d5", 0);
+  expect_see("4k3/8/2p5/3p4/8/4N3/8/4K3 w - - 0 1", "e3d5", -200);
+  // Both sides keep recapturing while it pays.
+  expect_see("4k3/8/4p3/3p4/8/2N2B2/8/3RK3 w - - 0 1", "c3d5", -100);
+}
+
+BOOST_AUTO_TEST_CASE(xrays) {
+  // The queen behind the bishop recaptures last.
+  expect_see("4k3/8/1n3n2/3p4/8/1BN5/Q7/4K3 w - - 0 1", "c3d5", 100);
+  // The rook behind the defending rook wins the exchange for black.
+  expect_see("3rk3/3r4/8/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", -400);
+}
+
+BOOST_AUTO_TEST_CASE(kings) {
+  // The king cannot recapture on a square that is still attacked.
+  expect_see("8/8/8/4k3/3p4/8/3R4/3RK3 w - - 0 1", "d2d4", 100);
+  expect_see("8/8/8/4k3/3p4/8/3R4/4K3 w - - 0 1", "d2d4", -400);
+}
+
+BOOST_AUTO_TEST_CASE(special_moves) {
+  expect_see("3rk3/4P3/8/8/8/8/8/4K3 w - - 0 1", "e7d8q", 400);
+  expect_see("3r3k/4P3/8/8/8/8/8/4K3 w - - 0 1", "e7d8q", 1'300);
+  expect_see("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6", 100);
+  expect_see("4k3/2p5/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6", 0);
+  expect_see("4k3/8/8/8/8/8/8/4K2R w K - 0 1", "e1g1", 0);
+  // Quiet moves can lose material too.
+  expect_see("4k3/8/4p3/8/8/8/8/3QK3 w - - 0 1", "d1d5", -900);
+}
+}
+}
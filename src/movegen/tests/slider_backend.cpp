@@ -0,0 +1,34 @@
+#define BOOST_TEST_MODULE SliderBackend
+
+#include "movegen/slider_backend.h"
+
+#include <boost/test/tools/output_test_stream.hpp>
+#include <boost/test/unit_test.hpp>
+
+namespace prodigy::movegen {
+namespace {
+static_assert(sizeof(SliderBackend) == 1);
+
+static_assert(to_slider_backend("magic") == SliderBackend::MAGIC);
+static_assert(to_slider_backend("pext") == SliderBackend::PEXT);
+static_assert(to_slider_backend("hyperbola") == SliderBackend::HYPERBOLA_QUINTESSENCE);
+static_assert(!to_slider_backend("").has_value());
+static_assert(!to_slider_backend("magics").has_value());
+
+BOOST_AUTO_TEST_CASE(build_time_backend_is_supported) {
+  BOOST_TEST(is_supported(SliderBackend::MAGIC));
+  BOOST_TEST(is_supported(SliderBackend::HYPERBOLA_QUINTESSENCE));
+  BOOST_TEST(is_supported(SLIDER_BACKEND));
+}
+
+BOOST_AUTO_TEST_CASE(output_stream) {
+  boost::test_tools::output_test_stream os;
+  os << SliderBackend::MAGIC;
+  BOOST_TEST(os.is_equal("magic"));
+  os << SliderBackend::PEXT;
+  BOOST_TEST(os.is_equal("pext"));
+  os << SliderBackend::HYPERBOLA_QUINTESSENCE;
+  BOOST_TEST(os.is_equal("hyperbola"));
+}
+}
+}
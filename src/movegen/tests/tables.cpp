@@ -0,0 +1,81 @@
+#define BOOST_TEST_MODULE Tables
+
+#include "movegen/tables.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "base/uniform_distribution.h"
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/piece_type.h"
+#include "movegen/slider_backend.h"
+
+namespace prodigy::movegen {
+namespace {
+board::Bitboard random_occupancy() {
+  board::Bitboard occupancy;
+  for (auto pieces = uniform_distribution(2, 32); pieces; --pieces) {
+    occupancy |= board::Bitboard(static_cast<board::Coordinate>(uniform_distribution(0, 63)));
+  }
+  return occupancy;
+}
+
+BOOST_AUTO_TEST_CASE(instance) { BOOST_TEST(&Tables::instance() == &Tables::instance()); }
+
+BOOST_AUTO_TEST_CASE(lines_extend_rays) {
+  const auto& tables = Tables::instance();
+  board::for_each_coordinate([&](const auto origin) {
+    board::for_each_coordinate([&](const auto target) {
+      if (target == origin) {
+        return;
+      }
+      const auto line = tables.line(origin, target);
+      BOOST_TEST_REQUIRE((line == tables.line(target, origin)));
+      BOOST_TEST_REQUIRE(((tables.ray(origin, target) & ~line) == board::Bitboard()));
+      if (line) {
+        BOOST_TEST_REQUIRE(static_cast<bool>(line & board::Bitboard(origin)));
+        BOOST_TEST_REQUIRE(static_cast<bool>(line & board::Bitboard(target)));
+      } else {
+        BOOST_TEST_REQUIRE(!tables.ray(origin, target));
+      }
+    });
+  });
+}
+
+BOOST_AUTO_TEST_CASE(slider_backends_agree) {
+  const auto& tables = Tables::instance();
+  const auto expect_agrees_with_magic = [&]<SliderBackend SLIDER_BACKEND> {
+    for (auto i = 0; i < 10'000; ++i) {
+      const auto occupancy = random_occupancy();
+      board::for_each_coordinate([&](const auto origin) {
+        const auto expect_equal = [&]<board::PieceType PIECE_TYPE> {
+          BOOST_TEST_REQUIRE(
+              (tables.attack_set<board::Color::WHITE, PIECE_TYPE, SLIDER_BACKEND>(origin, occupancy) ==
+               tables.attack_set<board::Color::WHITE, PIECE_TYPE, SliderBackend::MAGIC>(origin, occupancy)));
+        };
+        expect_equal.template operator()<board::PieceType::BISHOP>();
+        expect_equal.template operator()<board::PieceType::ROOK>();
+        expect_equal.template operator()<board::PieceType::QUEEN>();
+      });
+    }
+  };
+#ifdef PRODIGY_PEXT
+  if (is_supported(SliderBackend::PEXT)) {
+    expect_agrees_with_magic.template operator()<SliderBackend::PEXT>();
+  }
+#endif
+  expect_agrees_with_magic.template operator()<SliderBackend::HYPERBOLA_QUINTESSENCE>();
+}
+
+BOOST_AUTO_TEST_CASE(build_time_slider_backend) {
+  const auto& tables = Tables::instance();
+  const auto occupancy = random_occupancy();
+  board::for_each_coordinate([&](const auto origin) {
+    BOOST_TEST_REQUIRE((tables.attack_set<board::Color::WHITE, board::PieceType::QUEEN>(origin, occupancy) ==
+                        tables.attack_set<board::Color::WHITE, board::PieceType::QUEEN, SLIDER_BACKEND>(origin,
+                                                                                                        occupancy)));
+  });
+}
+}
+}
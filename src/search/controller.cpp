@@ -6,14 +6,15 @@
 namespace prodigy::search {
 Controller::Controller(std::unique_ptr<Searcher> searcher) : searcher_(std::move(searcher)) { BOOST_ASSERT(searcher_); }
 
-bool Controller::start_searching(board::Position&& position,
+bool Controller::start_searching(board::Position&& position, History&& history,
                                  std::function<void(std::optional<board::Move>)>&& callback) {
   if (auto expected = Searcher::State::IDLE;
       !searcher_->state_.compare_exchange_strong(expected, Searcher::State::SEARCHING, std::memory_order_relaxed)) {
     return false;
   }
-  search_ = std::async(std::launch::async, [&, position = std::move(position), callback = std::move(callback)] {
-    const auto move = searcher_->search(position);
+  search_ = std::async(std::launch::async, [&, position = std::move(position), history = std::move(history),
+                                             callback = std::move(callback)] mutable {
+    const auto move = searcher_->search(position, history);
     searcher_->state_.store(Searcher::State::IDLE, std::memory_order_relaxed);
     callback(move);
   });
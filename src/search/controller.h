@@ -7,6 +7,7 @@
 
 #include "board/move.h"
 #include "board/position.h"
+#include "search/history.h"
 #include "search/searcher.h"
 
 namespace prodigy::search {
@@ -17,7 +18,7 @@ class Controller final {
   Controller(const Controller&) = delete;
   Controller& operator=(const Controller&) = delete;
 
-  bool start_searching(board::Position&&, std::function<void(std::optional<board::Move>)>&&);
+  bool start_searching(board::Position&&, History&&, std::function<void(std::optional<board::Move>)>&&);
   bool stop_searching();
 
  private:
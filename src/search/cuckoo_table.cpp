@@ -0,0 +1,59 @@
+#include "search/cuckoo_table.h"
+
+#include <boost/assert.hpp>
+
+#include "board/bitboard.h"
+#include "board/color.h"
+#include "board/piece_type.h"
+#include "movegen/tables.h"
+#include "zobrist/randoms.h"
+
+namespace prodigy::search {
+const CuckooTable& CuckooTable::instance() {
+  static const CuckooTable CUCKOO_TABLE;
+  return CUCKOO_TABLE;
+}
+
+std::optional<std::pair<board::Coordinate, board::Coordinate>> CuckooTable::find(const zobrist::Hash hash) const {
+  for (const auto index : {first_index(hash), second_index(hash)}) {
+    if (const auto& entry = entries_[index]; entry.hash == hash) {
+      return std::pair(entry.first, entry.second);
+    }
+  }
+  return std::nullopt;
+}
+
+CuckooTable::CuckooTable() {
+  const auto& tables = movegen::Tables::instance();
+  const auto& zobrist_randoms = zobrist::Randoms::instance();
+  [[maybe_unused]] auto entry_count = 0UZ;
+  for (const auto color : {board::Color::WHITE, board::Color::BLACK}) {
+    for (const auto piece_type : {board::PieceType::KNIGHT, board::PieceType::BISHOP, board::PieceType::ROOK,
+                                  board::PieceType::QUEEN, board::PieceType::KING}) {
+      board::for_each_coordinate([&](const auto first) {
+        board::for_each_coordinate(
+            tables.attack_set<board::Color::WHITE>(piece_type, first, board::Bitboard()), [&](const auto second) {
+              if (second < first) {
+                return;
+              }
+              Entry entry{.hash = zobrist_randoms.coordinate_random(color, piece_type, first) ^
+                                  zobrist_randoms.coordinate_random(color, piece_type, second) ^
+                                  zobrist_randoms.active_color_random(),
+                          .first = first,
+                          .second = second};
+              // Evicts whatever is in the way to its other index until an entry lands in an empty one.
+              for (auto index = first_index(entry.hash);;
+                   index = index == first_index(entry.hash) ? second_index(entry.hash) : first_index(entry.hash)) {
+                std::swap(entries_[index], entry);
+                if (entry.hash == 0) {
+                  break;
+                }
+              }
+              ++entry_count;
+            });
+      });
+    }
+  }
+  BOOST_ASSERT(entry_count == 3'668);
+}
+}
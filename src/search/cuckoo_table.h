@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "board/coordinate.h"
+#include "zobrist/hash.h"
+
+namespace prodigy::search {
+// Maps the hash difference that a reversible move makes to the two coordinates that it moves between, for every
+// knight, bishop, rook, queen and king move on an empty board. A position whose hash differs from an earlier one by
+// such a move, with nothing in between, can get back to it in one move. Cuckoo hashing keeps the lookup to two probes.
+class CuckooTable final {
+ public:
+  static const CuckooTable& instance();
+
+  CuckooTable(const CuckooTable&) = delete;
+  CuckooTable& operator=(const CuckooTable&) = delete;
+
+  std::optional<std::pair<board::Coordinate, board::Coordinate>> find(zobrist::Hash) const;
+
+ private:
+  static constexpr auto SIZE = 8'192UZ;
+
+  struct Entry final {
+    // Zero for an empty entry, which no move hashes to.
+    zobrist::Hash hash = 0;
+    board::Coordinate first = board::Coordinate::A1;
+    board::Coordinate second = board::Coordinate::A1;
+  };
+
+  static constexpr std::size_t first_index(const zobrist::Hash hash) { return hash % SIZE; }
+  static constexpr std::size_t second_index(const zobrist::Hash hash) { return (hash >> 16) % SIZE; }
+
+  CuckooTable();
+
+  std::array<Entry, SIZE> entries_;
+};
+}
@@ -0,0 +1,70 @@
+#include "search/history.h"
+
+#include <algorithm>
+#include <boost/assert.hpp>
+
+#include "board/bitboard.h"
+#include "movegen/tables.h"
+#include "search/cuckoo_table.h"
+
+namespace prodigy::search {
+void History::pop() {
+  BOOST_ASSERT(size_ != 0);
+  --size_;
+}
+
+bool History::is_repetition(const board::Position& position, const Ply ply) const {
+  auto repeated_before_root = false;
+  for (auto distance = 4UZ, end = lookback(position); distance <= end; distance += 2) {
+    if (hash_before(distance) != position.hash()) {
+      continue;
+    }
+    if (distance < ply || repeated_before_root) {
+      return true;
+    }
+    repeated_before_root = true;
+  }
+  return false;
+}
+
+bool History::has_upcoming_repetition(const board::Position& position, const Ply ply) const {
+  const auto& cuckoo_table = CuckooTable::instance();
+  const auto& tables = movegen::Tables::instance();
+  const auto end = lookback(position);
+  for (auto distance = 3UZ; distance <= end; distance += 2) {
+    const auto coordinates = cuckoo_table.find(position.hash() ^ hash_before(distance));
+    if (!coordinates.has_value()) {
+      continue;
+    }
+    const auto [first, second] = *coordinates;
+    if (tables.ray(first, second) & ~board::Bitboard(second) & position.occupancy()) {
+      continue;
+    }
+    if (distance < ply) {
+      return true;
+    }
+    // From before the root, the move has to be one that the side to move can make, and the position it repeats has
+    // to have repeated once already.
+    const auto piece = position.piece_at(position.piece_at(first) ? first : second);
+    if (piece.color() != position.active_color()) {
+      continue;
+    }
+    const auto repeated_hash = hash_before(distance);
+    for (auto earlier_distance = distance + 4; earlier_distance <= end; earlier_distance += 2) {
+      if (hash_before(earlier_distance) == repeated_hash) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+zobrist::Hash History::hash_before(const std::size_t distance) const {
+  BOOST_ASSERT(distance != 0 && distance <= std::min(size_, hashes_.size()));
+  return hashes_[(size_ - distance) % hashes_.size()];
+}
+
+std::size_t History::lookback(const board::Position& position) const {
+  return std::min<std::size_t>(position.halfmove_clock(), size_);
+}
+}
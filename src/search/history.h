@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+
+#include "base/ply.h"
+#include "board/position.h"
+#include "zobrist/hash.h"
+
+namespace prodigy::search {
+// The hashes of the positions that led to the current one, from the game and then from the search. Only the positions
+// since the last capture or pawn move can repeat, and the halfmove clock that counts them fits in a Ply, so the stack
+// wraps around and overwrites what can no longer repeat.
+class History final {
+ public:
+  // Takes the position that the next move is played from.
+  void push(const board::Position& position) { hashes_[size_++ % hashes_.size()] = position.hash(); }
+
+  void pop();
+
+  // Whether the position is a draw by repetition, ply plies into the search. Repeating a position from within the
+  // search is enough, as the side that can repeat it could also have repeated it again. Positions from before the root
+  // have to repeat twice.
+  bool is_repetition(const board::Position&, Ply ply) const;
+
+  // Whether the side to move can repeat an earlier position with one reversible move, in which case the position is at
+  // least a draw for it. Looked up with CuckooTable, so it catches the repetition a ply before is_repetition would.
+  bool has_upcoming_repetition(const board::Position&, Ply ply) const;
+
+ private:
+  // The hash of the position the distance plies back.
+  zobrist::Hash hash_before(std::size_t distance) const;
+
+  // How many plies back a position could still repeat the current one.
+  std::size_t lookback(const board::Position&) const;
+
+  std::array<zobrist::Hash, std::numeric_limits<Ply>::max() + 1UZ> hashes_{};
+  std::size_t size_ = 0;
+};
+}
@@ -1,17 +1,42 @@
 #include "search/random_searcher.h"
 
-#include "base/uniform_distribution.h"
+#include <algorithm>
+#include <cstddef>
+
 #include "board/color.h"
-#include "movegen/move_list.h"
 
 namespace prodigy::search {
-std::optional<board::Move> RandomSearcher::search(const board::Position& position) {
-  if (const auto moves = position.active_color() == board::Color::WHITE
-                             ? move_generator_.generate<board::Color::WHITE>(position)
-                             : move_generator_.generate<board::Color::BLACK>(position);
-      !moves.empty()) {
-    return moves[uniform_distribution<decltype(moves)::size_type>(0, moves.size() - 1)];
+RandomSearcher::RandomSearcher() : RandomSearcher(std::random_device{}()) {}
+
+RandomSearcher::RandomSearcher(const std::uint64_t seed) : engine_(seed) {}
+
+std::optional<board::Move> RandomSearcher::choose_move(const board::Position& position, std::mt19937_64& engine,
+                                                       History* const history) {
+  auto& [check_info, moves] = stack_[0];
+  const auto generate = [&]<board::Color ACTIVE_COLOR> {
+    check_info = move_generator_.check_info<ACTIVE_COLOR>(position);
+    auto* const end = move_generator_.generate<ACTIVE_COLOR>(position, check_info, moves.data());
+    if (history == nullptr) {
+      return end;
+    }
+    history->push(position);
+    auto* const non_repeating_end = std::partition(moves.data(), end, [&](const auto& scored_move) {
+      return !history->is_repetition(position.apply<ACTIVE_COLOR>(scored_move.move), 1);
+    });
+    history->pop();
+    return non_repeating_end != moves.data() ? non_repeating_end : end;
+  };
+  const auto* const end = position.active_color() == board::Color::WHITE
+                              ? generate.template operator()<board::Color::WHITE>()
+                              : generate.template operator()<board::Color::BLACK>();
+  if (end == moves.data()) {
+    return std::nullopt;
   }
-  return std::nullopt;
+  std::uniform_int_distribution<std::size_t> index(0, static_cast<std::size_t>(end - moves.data()) - 1);
+  return moves[index(engine)].move;
+}
+
+std::optional<board::Move> RandomSearcher::search(const board::Position& position, History& history) {
+  return choose_move(position, engine_, &history);
 }
 }
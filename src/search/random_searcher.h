@@ -1,11 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <random>
+
+#include "board/move.h"
+#include "board/position.h"
 #include "movegen/move_generator.h"
+#include "search/history.h"
 #include "search/searcher.h"
+#include "search/stack.h"
 
 namespace prodigy::search {
 class RandomSearcher final : public Searcher {
+ public:
+  RandomSearcher();
+  explicit RandomSearcher(std::uint64_t seed);
+
+  // Picks one of the legal moves uniformly with the engine, or nullopt if there are none. Seeding the engine makes the
+  // choice reproducible. Given the history of the game, leaves out the moves that draw by repetition unless every move
+  // does.
+  std::optional<board::Move> choose_move(const board::Position&, std::mt19937_64& engine, History* = nullptr);
+
  private:
-  std::optional<board::Move> search(const board::Position&) override;
+  std::optional<board::Move> search(const board::Position&, History&) override;
 
   const movegen::MoveGenerator move_generator_;
+  Stack stack_;
+  std::mt19937_64 engine_;
 };
 }
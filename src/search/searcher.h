@@ -6,6 +6,7 @@
 
 #include "board/move.h"
 #include "board/position.h"
+#include "search/history.h"
 
 namespace prodigy::search {
 class Searcher {
@@ -29,7 +30,8 @@ class Searcher {
     STOPPING,
   };
 
-  virtual std::optional<board::Move> search(const board::Position&) = 0;
+  // The history holds the positions before this one, and is the searcher's to push onto and pop from as it searches.
+  virtual std::optional<board::Move> search(const board::Position&, History&) = 0;
 
   std::atomic<State> state_ = State::IDLE;
 };
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+
+#include "base/ply.h"
+#include "movegen/check_info.h"
+#include "movegen/move_list.h"
+#include "movegen/scored_move.h"
+
+namespace prodigy::search {
+struct Frame final {
+  movegen::CheckInfo check_info;
+  std::array<movegen::ScoredMove, movegen::MAX_MOVES> moves;
+};
+
+// Owned by a single search thread and indexed by the ply from the root.
+using Stack = std::array<Frame, MAX_PLY>;
+}
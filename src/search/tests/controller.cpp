@@ -13,6 +13,7 @@
 #include "board/coordinate.h"
 #include "board/move.h"
 #include "board/position.h"
+#include "search/history.h"
 #include "search/searcher.h"
 
 namespace prodigy::board {
@@ -33,7 +34,7 @@ class NoopSearcher final : public Searcher {
   explicit NoopSearcher(const std::optional<board::Move> move = std::nullopt) : move_(move) {}
 
  private:
-  std::optional<board::Move> search(const board::Position&) override {
+  std::optional<board::Move> search(const board::Position&, History&) override {
     while (keep_searching()) {
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
@@ -45,15 +46,18 @@ class NoopSearcher final : public Searcher {
 
 BOOST_AUTO_TEST_CASE(start_searching_while_searching) {
   Controller controller(std::make_unique<NoopSearcher>());
-  BOOST_TEST(controller.start_searching(board::Position(board::Position::starting_position()), [](auto&&) {}));
-  BOOST_TEST(!controller.start_searching(board::Position(board::Position::starting_position()), [](auto&&) {}));
+  BOOST_TEST(
+      controller.start_searching(board::Position(board::Position::starting_position()), History(), [](auto&&) {}));
+  BOOST_TEST(
+      !controller.start_searching(board::Position(board::Position::starting_position()), History(), [](auto&&) {}));
   BOOST_TEST(controller.stop_searching());
 }
 
 BOOST_AUTO_TEST_CASE(stop_searching_while_not_searching) {
   Controller controller(std::make_unique<NoopSearcher>());
   BOOST_TEST(!controller.stop_searching());
-  BOOST_TEST(controller.start_searching(board::Position(board::Position::starting_position()), [](auto&&) {}));
+  BOOST_TEST(
+      controller.start_searching(board::Position(board::Position::starting_position()), History(), [](auto&&) {}));
   BOOST_TEST(controller.stop_searching());
   BOOST_TEST(!controller.stop_searching());
 }
@@ -63,7 +67,7 @@ BOOST_AUTO_TEST_CASE(search) {
   Controller controller(std::make_unique<NoopSearcher>(move));
   const auto search_once = [&] {
     std::atomic<std::optional<board::Move>> search_result;
-    BOOST_TEST(controller.start_searching(board::Position(board::Position::starting_position()),
+    BOOST_TEST(controller.start_searching(board::Position(board::Position::starting_position()), History(),
                                           [&](const auto move) { search_result = move; }));
     BOOST_TEST(controller.stop_searching());
     while (!search_result.load().has_value()) {
@@ -0,0 +1,37 @@
+#define BOOST_TEST_MODULE CuckooTable
+
+#include "search/cuckoo_table.h"
+
+#include <boost/test/unit_test.hpp>
+#include <optional>
+#include <utility>
+
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/move.h"
+#include "board/position.h"
+
+namespace prodigy::search {
+namespace {
+zobrist::Hash hash_difference(const board::Position& position, const board::Move move) {
+  return position.hash() ^ position.apply<board::Color::WHITE>(position.annotate<board::Color::WHITE>(move)).hash();
+}
+
+BOOST_AUTO_TEST_CASE(find) {
+  const auto& cuckoo_table = CuckooTable::instance();
+  const auto& starting_position = board::Position::starting_position();
+  BOOST_TEST((cuckoo_table.find(hash_difference(starting_position, board::Move(board::Coordinate::G1,
+                                                                                board::Coordinate::F3))) ==
+              std::pair(board::Coordinate::G1, board::Coordinate::F3)));
+  BOOST_TEST(!cuckoo_table.find(hash_difference(starting_position,
+                                                board::Move(board::Coordinate::E2, board::Coordinate::E3)))
+                  .has_value());
+
+  const auto position = board::Position::from_fen("4k3/8/8/8/8/8/8/Q3K3 w - - 0 1");
+  BOOST_TEST((cuckoo_table.find(hash_difference(position, board::Move(board::Coordinate::A1, board::Coordinate::H8))) ==
+              std::pair(board::Coordinate::A1, board::Coordinate::H8)));
+  BOOST_TEST((cuckoo_table.find(hash_difference(position, board::Move(board::Coordinate::E1, board::Coordinate::D2))) ==
+              std::pair(board::Coordinate::E1, board::Coordinate::D2)));
+}
+}
+}
@@ -0,0 +1,72 @@
+#define BOOST_TEST_MODULE History
+
+#include "search/history.h"
+
+#include <boost/test/unit_test.hpp>
+#include <initializer_list>
+
+#include "board/color.h"
+#include "board/coordinate.h"
+#include "board/move.h"
+#include "board/position.h"
+
+namespace prodigy::search {
+namespace {
+// Pushes each position onto the history before playing the move from it.
+board::Position play(board::Position position, History& history, const std::initializer_list<board::Move> moves) {
+  for (const auto move : moves) {
+    history.push(position);
+    position = position.active_color() == board::Color::WHITE
+                   ? position.apply<board::Color::WHITE>(position.annotate<board::Color::WHITE>(move))
+                   : position.apply<board::Color::BLACK>(position.annotate<board::Color::BLACK>(move));
+  }
+  return position;
+}
+
+const auto KNIGHTS_OUT_AND_BACK = {board::Move(board::Coordinate::G1, board::Coordinate::F3),
+                                   board::Move(board::Coordinate::G8, board::Coordinate::F6),
+                                   board::Move(board::Coordinate::F3, board::Coordinate::G1),
+                                   board::Move(board::Coordinate::F6, board::Coordinate::G8)};
+
+BOOST_AUTO_TEST_CASE(is_repetition) {
+  History history;
+  auto position = play(board::Position::starting_position(), history, KNIGHTS_OUT_AND_BACK);
+  BOOST_TEST(!history.is_repetition(position, 0));
+  BOOST_TEST(!history.is_repetition(position, 4));
+  BOOST_TEST(history.is_repetition(position, 5));
+
+  position = play(position, history, KNIGHTS_OUT_AND_BACK);
+  BOOST_TEST(history.is_repetition(position, 0));
+  // The same position with a halfmove clock of zero was just reached by a capture or a pawn move, so it cannot repeat.
+  BOOST_TEST(!history.is_repetition(board::Position::starting_position(), 0));
+}
+
+BOOST_AUTO_TEST_CASE(has_upcoming_repetition) {
+  const auto knights_out_and_white_back = {board::Move(board::Coordinate::G1, board::Coordinate::F3),
+                                           board::Move(board::Coordinate::G8, board::Coordinate::F6),
+                                           board::Move(board::Coordinate::F3, board::Coordinate::G1)};
+  History history;
+  auto position = play(board::Position::starting_position(), history, knights_out_and_white_back);
+  BOOST_TEST(!history.has_upcoming_repetition(position, 0));
+  BOOST_TEST(history.has_upcoming_repetition(position, 4));
+
+  history = {};
+  position = play(board::Position::starting_position(), history, KNIGHTS_OUT_AND_BACK);
+  position = play(position, history, knights_out_and_white_back);
+  BOOST_TEST(history.has_upcoming_repetition(position, 0));
+
+  // The rook can only go straight back to a1 if nothing is on a2.
+  const auto rook_around = {board::Move(board::Coordinate::A1, board::Coordinate::B1),
+                            board::Move(board::Coordinate::E8, board::Coordinate::D8),
+                            board::Move(board::Coordinate::B1, board::Coordinate::B3),
+                            board::Move(board::Coordinate::D8, board::Coordinate::E8),
+                            board::Move(board::Coordinate::B3, board::Coordinate::A3)};
+  history = {};
+  position = play(board::Position::from_fen("4k3/8/8/8/8/8/8/R3K3 w - - 0 1"), history, rook_around);
+  BOOST_TEST(history.has_upcoming_repetition(position, 6));
+  history = {};
+  position = play(board::Position::from_fen("4k3/8/8/8/8/8/N7/R3K3 w - - 0 1"), history, rook_around);
+  BOOST_TEST(!history.has_upcoming_repetition(position, 6));
+}
+}
+}
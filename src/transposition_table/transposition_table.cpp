@@ -4,6 +4,8 @@ namespace prodigy::transposition_table {
 TranspositionTable::TranspositionTable(const std::size_t megabytes)
     : buckets_(megabytes * (1 << 20) / sizeof(Bucket)) {}
 
+void TranspositionTable::prefetch(const Key key) const { __builtin_prefetch(&buckets_[key % buckets_.size()]); }
+
 std::optional<Value> TranspositionTable::find(const Key key) {
   return buckets_[key % buckets_.size()].find(key, generation_);
 }
@@ -23,6 +23,8 @@ class TranspositionTable final {
   TranspositionTable(TranspositionTable&&) = delete;
   TranspositionTable& operator=(TranspositionTable&&) = delete;
 
+  // Starts loading the bucket for the key into cache, so that a later find or try_insert does not stall on memory.
+  void prefetch(Key) const;
   [[nodiscard]] std::optional<Value> find(Key);
   bool try_insert(Key, board::Move, eval::Score, Ply depth, search::NodeType);
   void advance_generation();
@@ -18,11 +18,11 @@ class alignas(std::uint64_t) Value final {
  public:
   constexpr Value(const board::Move move, const eval::Score score, const Ply depth, const search::NodeType node_type,
                   const Ply generation)
-      : move_(move), score_(score), depth_(depth), node_type_(node_type), generation_(generation) {
+      : move_(move.compact()), score_(score), depth_(depth), node_type_(node_type), generation_(generation) {
     BOOST_ASSERT(std::in_range<decltype(score_)>(score));
   }
 
-  constexpr board::Move move() const { return move_; }
+  constexpr board::Move move() const { return board::Move::from_compact(move_); }
   constexpr eval::Score score() const { return score_; }
   constexpr Ply depth() const { return depth_; }
   constexpr search::NodeType node_type() const { return node_type_; }
@@ -32,7 +32,7 @@ class alignas(std::uint64_t) Value final {
   friend constexpr bool operator==(Value, Value) = default;
 
  private:
-  board::Move move_;
+  std::uint16_t move_;
   std::int16_t score_;
   Ply depth_;
   search::NodeType node_type_;
@@ -40,9 +40,12 @@ void Handler::handle(UciNewGame) { position_.reset(); }
 
 void Handler::handle(Position&& position) {
   position_ = std::move(position.position);
+  history_ = {};
   for (const auto move : position.moves) {
-    position_ = position_->active_color() == board::Color::WHITE ? position_->apply<board::Color::WHITE>(move)
-                                                                 : position_->apply<board::Color::BLACK>(move);
+    history_.push(*position_);
+    position_ = position_->active_color() == board::Color::WHITE
+                    ? position_->apply<board::Color::WHITE>(position_->annotate<board::Color::WHITE>(move))
+                    : position_->apply<board::Color::BLACK>(position_->annotate<board::Color::BLACK>(move));
   }
 }
 
@@ -51,7 +54,7 @@ void Handler::handle(Go&&) {
     std::clog << __func__ << ": unknown position\n";
     return;
   }
-  controller_.start_searching(std::move(*position_), [&](const auto move) {
+  controller_.start_searching(std::move(*position_), std::move(history_), [&](const auto move) {
     move.has_value() ? output("bestmove ", *move) : output("bestmove 0000");
   });
   position_.reset();
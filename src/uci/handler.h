@@ -7,6 +7,7 @@
 
 #include "board/position.h"
 #include "search/controller.h"
+#include "search/history.h"
 #include "search/searcher.h"
 #include "uci/messages.h"
 
@@ -37,6 +38,7 @@ class Handler final {
 
   std::ostream& output_;
   std::optional<board::Position> position_;
+  search::History history_;
   search::Controller controller_;
 };
 }
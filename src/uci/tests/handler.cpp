@@ -6,13 +6,15 @@
 #include <boost/test/unit_test.hpp>
 #include <memory>
 
+#include "search/history.h"
+#include "search/random_searcher.h"
 #include "search/searcher.h"
 
 namespace prodigy::uci {
 namespace {
 class NoopSearcher final : public search::Searcher {
  private:
-  std::optional<board::Move> search(const board::Position&) override { return std::nullopt; }
+  std::optional<board::Move> search(const board::Position&, search::History&) override { return std::nullopt; }
 };
 
 struct Fixture {
@@ -88,5 +90,18 @@ BOOST_AUTO_TEST_CASE(go) {
   }
   BOOST_TEST(output.is_equal("bestmove 0000\n"));
 }
+
+BOOST_AUTO_TEST_CASE(go_avoids_repetition) {
+  // White's king and pawn cannot move, so the knight on h1 has only Ng3 and Nf2. It has shuttled between h1 and g3
+  // against black's king, so Ng3 would repeat a position a third time and Nf2 is the one move left.
+  boost::test_tools::output_test_stream output;
+  {
+    Handler handler(output, std::make_unique<search::RandomSearcher>());
+    BOOST_TEST(handler.handle("position fen 1r5k/8/8/8/8/p5N1/P7/K7 b - - 0 1 moves h8g8 g3h1 g8h8 h1g3 h8g8 g3h1 "
+                              "g8h8"));
+    BOOST_TEST(handler.handle("go"));
+  }
+  BOOST_TEST(output.is_equal("bestmove h1f2\n"));
+}
 }
 }
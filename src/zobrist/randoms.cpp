@@ -1,27 +1,46 @@
 #include "zobrist/randoms.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
-#include "base/uniform_distribution.h"
-
 namespace prodigy::zobrist {
 namespace {
+// Fixed, so that a position hashes the same in every process on every machine.
+constexpr std::uint64_t SEED = 0x7072'6F64'6967'7921;
+constexpr std::uint64_t GOLDEN_GAMMA = 0x9E37'79B9'7F4A'7C15;
+
+// The output of SplitMix64 at the index, which only depends on the index so that each table can take its own range of
+// indices.
+constexpr Hash split_mix_random(const std::size_t index) {
+  auto z = SEED + (index + 1) * GOLDEN_GAMMA;
+  z = (z ^ (z >> 30)) * 0xBF58'476D'1CE4'E5B9;
+  z = (z ^ (z >> 27)) * 0x94D0'49BB'1331'11EB;
+  return z ^ (z >> 31);
+}
+
 template <typename T>
-auto make_uniform_randoms() {
+constexpr auto make_split_mix_randoms(std::size_t first_index) {
   std::remove_const_t<T> randoms;
   for (auto& random : randoms) {
-    random = uniform_distribution<Hash>();
+    random = split_mix_random(first_index++);
   }
   return randoms;
 }
+
+constexpr auto PIECE_RANDOM_COUNT = 12UZ * 64;
+constexpr auto ACTIVE_COLOR_RANDOM_INDEX = PIECE_RANDOM_COUNT;
+constexpr auto FIRST_CASTLING_RIGHTS_RANDOM_INDEX = ACTIVE_COLOR_RANDOM_INDEX + 1;
+constexpr auto FIRST_EN_PASSANT_FILE_RANDOM_INDEX = FIRST_CASTLING_RIGHTS_RANDOM_INDEX + 16;
 }
 
-Randoms::Randoms()
+constexpr Randoms::Randoms()
     : piece_to_coordinate_to_random_([] {
         std::remove_const_t<decltype(piece_to_coordinate_to_random_)> randoms;
+        auto index = 0UZ;
         board::for_each_coordinate([&](const auto coordinate) {
-#define _(COLOR, PIECE_TYPE) \
-  randoms.get<board::Color::COLOR, board::PieceType::PIECE_TYPE>()[coordinate] = uniform_distribution<Hash>()
+#define _(COLOR, PIECE_TYPE)                                                                               \
+  randoms.get<board::Color::COLOR, board::PieceType::PIECE_TYPE>()[coordinate] = split_mix_random(index++)
           _(WHITE, PAWN);
           _(WHITE, KNIGHT);
           _(WHITE, BISHOP);
@@ -38,13 +57,14 @@ Randoms::Randoms()
         });
         return randoms;
       }()),
-      active_color_random_(uniform_distribution<Hash>()),
-      castling_rights_to_random_(make_uniform_randoms<decltype(castling_rights_to_random_)>()),
-      en_passant_file_to_random_(make_uniform_randoms<decltype(en_passant_file_to_random_)>()) {
-}
+      active_color_random_(split_mix_random(ACTIVE_COLOR_RANDOM_INDEX)),
+      castling_rights_to_random_(
+          make_split_mix_randoms<decltype(castling_rights_to_random_)>(FIRST_CASTLING_RIGHTS_RANDOM_INDEX)),
+      en_passant_file_to_random_(
+          make_split_mix_randoms<decltype(en_passant_file_to_random_)>(FIRST_EN_PASSANT_FILE_RANDOM_INDEX)) {}
 
 const Randoms& Randoms::instance() {
-  static const Randoms RANDOMS;
+  static constexpr Randoms RANDOMS;
   return RANDOMS;
 }
 
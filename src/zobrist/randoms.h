@@ -20,12 +20,13 @@ class Randoms final {
 
   template <board::Color, board::PieceType>
   Hash coordinate_random(board::Coordinate) const;
+  Hash coordinate_random(board::Color, board::PieceType, board::Coordinate) const;
   Hash active_color_random() const;
   Hash castling_rights_random(board::CastlingRights) const;
   Hash en_passant_file_random(board::File) const;
 
  private:
-  Randoms();
+  constexpr Randoms();
 
   const board::PieceMap<board::CoordinateMap<Hash>> piece_to_coordinate_to_random_;
   const Hash active_color_random_;
@@ -37,4 +38,9 @@ template <board::Color COLOR, board::PieceType PIECE_TYPE>
 Hash Randoms::coordinate_random(const board::Coordinate coordinate) const {
   return piece_to_coordinate_to_random_.get<COLOR, PIECE_TYPE>()[coordinate];
 }
+
+inline Hash Randoms::coordinate_random(const board::Color color, const board::PieceType piece_type,
+                                       const board::Coordinate coordinate) const {
+  return piece_to_coordinate_to_random_.get(color, piece_type)[coordinate];
+}
 }